@@ -1,8 +1,16 @@
 #include "Application.h"
+#include "CursorCapture.h"
+#include "FrameCost.h"
+#include "InputRecorder.h"
+#include "GpuFigureRenderer.h"
+#include "GpuMorphKernel.h"
+#include "StartupTrace.h"
 
 #include <imgui_internal.h>
 
 #include <iostream>
+#include <algorithm>
+#include <future>
 #include <cstdlib>
 
 //
@@ -16,18 +24,35 @@ void ImGuiVulkanGlfwApplication::Run()
   Cleanup();
 }
 
+void ImGuiVulkanGlfwApplication::RecordInput(
+    const std::string & path
+  )
+{
+  InputRecorder::Instance().StartRecording(path);
+}
+
+void ImGuiVulkanGlfwApplication::ReplayInput(
+    const std::string & path,
+    const bool          headless
+  )
+{
+  InputRecorder::Instance().StartReplay(path, headless);
+  m_IsReplay = true;
+  m_IsHeadless = headless;
+}
+
 void ImGuiVulkanGlfwApplication::AddWindow(
     std::shared_ptr<IWindow> && window
   )
 {
-  m_Windows.push_back(std::move(window));
+  m_Windows.Add(std::move(window));
 }
 
 void ImGuiVulkanGlfwApplication::AddWindow(
     const std::shared_ptr<IWindow> & window
   )
 {
-  m_Windows.push_back(window);
+  m_Windows.Add(window);
 }
 
 //
@@ -36,45 +61,85 @@ void ImGuiVulkanGlfwApplication::AddWindow(
 
 void ImGuiVulkanGlfwApplication::Init()
 {
-  SetupGlfwWindow();
-  SetupVulkan();
-  auto surface = CreateWindowSurface();
-  CreateFramebuffers(surface);
-
-  SetupImGuiContext();
-  SetupImGuiStyle();
-  SetupBackends();
-  UploadFonts();
+  auto & Trace = StartupTrace::Instance();
+  Trace.Start();
+
+  // Rasterized (or read from the cache) while the window and the device
+  // are set up
+  m_FontLoader.Start(FontAtlasSpec{}, "cache");
+
+  Trace.Run("GLFW init", [this] { InitGlfw(); });
+
+  // The device only needs GLFW for the instance extensions, it is created
+  // while the main thread (GLFW requires it) opens the window and sets up
+  // ImGui. The worker makes no ImGui calls
+  auto Vulkan = std::async(std::launch::async, [this] { SetupVulkan(); });
+
+  Trace.Run("Create window", [this] { CreateGlfwWindow(); });
+  Trace.Run("ImGui context", [this] { SetupImGuiContext(); });
+  Trace.Run("ImGui style", [this] { SetupImGuiStyle(); });
+  Trace.Run("ImGui GLFW backend", [this] { SetupGlfwBackend(); });
+  Trace.Run("Wait for device", [&] { Vulkan.get(); });
+
+  // Swapchain creation allocates through ImGui and stays on this thread
+  VkSurfaceKHR surface = VK_NULL_HANDLE;
+  Trace.Run("Window surface", [&] { surface = CreateWindowSurface(); });
+  Trace.Run("Swapchain", [&] { CreateFramebuffers(surface); });
+
+  // The pipelines are independent of each other
+  auto Renderer = std::async(std::launch::async, [&] { Trace.Run("Figure renderer pipeline", [this] { SetupGpuFigureRenderer(); }); });
+  auto Kernel = std::async(std::launch::async, [&] { Trace.Run("Morph kernel pipeline", [this] { SetupGpuMorphKernel(); }); });
+
+  Trace.Run("ImGui Vulkan backend", [this] { SetupVulkanBackend(); });
+  Trace.Run("Wait for pipelines", [&] { Renderer.get(); Kernel.get(); });
+  Trace.Run("Font upload", [this] { UploadFonts(); });
 }
 
 void ImGuiVulkanGlfwApplication::MainLoop()
 {
+  FrameArena::SetCurrent(&m_FrameArena);
+
   while (!glfwWindowShouldClose(m_Window))
   {
-    glfwPollEvents();
+    // Nothing allocated from the arena outlives the frame
+    m_FrameArena.Reset();
+
+    PollEvents();
+    InputRecorder::Instance().BeginFrame();
+    CursorCapture::Instance().BeginFrame();
 
-    if (m_SwapChainRebuild)
     {
       int width, height;
       glfwGetFramebufferSize(m_Window, &width, &height);
-      if (width > 0 && height > 0)
+      m_Resize.Update(width, height);
+
+      // An out of date swapchain can not be presented to and is rebuilt
+      // right away, a merely stale one waits for the resize to settle
+      const bool IsDue = m_SwapChainRebuild
+        || m_Resize.IsRebuildDue(m_MainWindowData.Width, m_MainWindowData.Height)
+        || (m_SwapChainSuboptimal && !m_Resize.IsResizing());
+
+      if (width > 0 && height > 0 && IsDue)
       {
-        ImGui_ImplVulkan_SetMinImageCount(m_MinImageCount);
-        ImGui_ImplVulkanH_CreateOrResizeWindow(m_Instance, m_PhysicalDevice, m_Device, &m_MainWindowData, m_QueueFamily, m_Allocator, width, height, m_MinImageCount);
-        m_MainWindowData.FrameIndex = 0;
+        const auto Start = ResizeMonitor::Clock::now();
+        RebuildSwapchain(width, height);
+        m_Resize.OnRebuild(Start, ResizeMonitor::Clock::now());
         m_SwapChainRebuild = false;
+        m_SwapChainSuboptimal = false;
       }
     }
 
     // Start the Dear ImGui frame
     ImGui_ImplVulkan_NewFrame();
     ImGui_ImplGlfw_NewFrame();
+    InputRecorder::Instance().ApplyDeltaTime();
     ImGui::NewFrame();
 
     ShowDockSpace();
 
-    for (auto & Window : m_Windows)
-      Window->Show();
+    m_Windows.Show();
+
+    FrameCost::Instance().EndFrame();
 
     const auto WasRender = FrameRender();
 
@@ -87,18 +152,70 @@ void ImGuiVulkanGlfwApplication::MainLoop()
 
     // Present Main Platform Window
     if (WasRender)
+    {
       FramePresent();
+      m_Resize.OnFramePresented();
+    }
+
+    if (ResizeMonitor::Summary Summary; m_Resize.PopSummary(Summary))
+      ResizeMonitor::Print(std::cout, Summary);
+
+    FinishFontUpload();
+
+    if (WasRender && m_IsFirstFrame)
+    {
+      StartupTrace::Instance().MarkFirstFrame();
+      ReportStartup();
+      m_IsFirstFrame = false;
+    }
+
+    GpuFigureRenderer::Instance().EndFrame();
+    GpuMorphKernel::Instance().EndFrame();
+  }
+}
+
+void ImGuiVulkanGlfwApplication::PollEvents()
+{
+  // With nothing animating on screen the next frame would repeat the last
+  // one, so the loop sleeps until input arrives. ImGui settles hover and
+  // layout changes over a few frames, those are drawn after every event.
+  const bool IsIdle = !m_IsFirstFrame
+    && InputRecorder::Instance().GetMode() == InputRecorder::Mode::Off
+    && !m_SwapChainRebuild
+    && !m_SwapChainSuboptimal
+    && !m_Resize.IsResizing()
+    && !m_FontUploadFence
+    && !m_Windows.IsAnimating();
+
+  if (!IsIdle || m_SettleFrames > 0)
+  {
+    m_SettleFrames = std::max(m_SettleFrames - 1, 0);
+    glfwPollEvents();
+    return;
   }
+
+  const auto Start = glfwGetTime();
+  glfwWaitEventsTimeout(IDLE_WAIT_TIMEOUT);
+
+  if (glfwGetTime() - Start < IDLE_WAIT_TIMEOUT)
+    m_SettleFrames = IDLE_SETTLE_FRAMES;
 }
 
 void ImGuiVulkanGlfwApplication::Cleanup()
 {
   // Cleanup
+  InputRecorder::Instance().Finish();
+  FrameArena::SetCurrent(nullptr);
+
   const auto err = vkDeviceWaitIdle(m_Device);
   check_vk_result(err);
+  FinishFontUpload();
+  GpuMorphKernel::Instance().Shutdown();
+  GpuFigureRenderer::Instance().Shutdown();
   ImGui_ImplVulkan_Shutdown();
   ImGui_ImplGlfw_Shutdown();
   ImGui::DestroyContext();
+  m_FontAtlas.reset();
 
   ImGui_ImplVulkanH_DestroyWindow(m_Instance, m_Device, &m_MainWindowData, m_Allocator);
 
@@ -117,27 +234,37 @@ void ImGuiVulkanGlfwApplication::Cleanup()
   glfwTerminate();
 }
 
-void ImGuiVulkanGlfwApplication::SetupGlfwWindow()
+void ImGuiVulkanGlfwApplication::InitGlfw()
 {
   glfwSetErrorCallback(glfw_error_callback);
 
   if (!glfwInit())
     throw std::runtime_error("GLFW: Failed to init window\n");
 
+  if (!glfwVulkanSupported())
+    throw std::runtime_error("GLFW: Vulkan not supported\n");
+}
+
+void ImGuiVulkanGlfwApplication::CreateGlfwWindow()
+{
   glfwWindowHint(GLFW_CLIENT_API, GLFW_NO_API);
+  if (m_IsHeadless)
+    glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
   m_Window = glfwCreateWindow(1920, 1080, "2D Morphing", NULL, NULL);
+
+  // Installed before the ImGui backend, which chains to it
+  CursorCapture::Instance().Attach(m_Window);
 }
 
 void ImGuiVulkanGlfwApplication::SetupVulkan()
 {
-  if (!glfwVulkanSupported())
-    throw std::runtime_error("GLFW: Vulkan not supported\n");
+  auto & Trace = StartupTrace::Instance();
 
-  CreateVulkanInstance();
-  SelectGPU();
-  SelectGraphicsQueueFamily();
-  CreateLogicalDevice();
-  CreateDescriptorPool();
+  Trace.Run("Vulkan instance", [this] { CreateVulkanInstance(); });
+  Trace.Run("Select GPU", [this] { SelectGPU(); });
+  Trace.Run("Select queue family", [this] { SelectGraphicsQueueFamily(); });
+  Trace.Run("Logical device", [this] { CreateLogicalDevice(); });
+  Trace.Run("Descriptor pool", [this] { CreateDescriptorPool(); });
 }
 
 void ImGuiVulkanGlfwApplication::CreateVulkanInstance()
@@ -317,7 +444,12 @@ void ImGuiVulkanGlfwApplication::CreateFramebuffers(VkSurfaceKHR surface)
 #else
   VkPresentModeKHR present_modes[] = { VK_PRESENT_MODE_FIFO_KHR };
 #endif
-  wd->PresentMode = ImGui_ImplVulkanH_SelectPresentMode(m_PhysicalDevice, wd->Surface, &present_modes[0], IM_ARRAYSIZE(present_modes));
+  // Replayed frame times are not capped by the display refresh
+  VkPresentModeKHR replay_present_modes[] = { VK_PRESENT_MODE_MAILBOX_KHR, VK_PRESENT_MODE_IMMEDIATE_KHR, VK_PRESENT_MODE_FIFO_KHR };
+  if (m_IsReplay)
+    wd->PresentMode = ImGui_ImplVulkanH_SelectPresentMode(m_PhysicalDevice, wd->Surface, &replay_present_modes[0], IM_ARRAYSIZE(replay_present_modes));
+  else
+    wd->PresentMode = ImGui_ImplVulkanH_SelectPresentMode(m_PhysicalDevice, wd->Surface, &present_modes[0], IM_ARRAYSIZE(present_modes));
   //printf("[vulkan] Selected PresentMode = %d\n", wd->PresentMode);
 
   // Create SwapChain, RenderPass, Framebuffer, etc.
@@ -325,10 +457,144 @@ void ImGuiVulkanGlfwApplication::CreateFramebuffers(VkSurfaceKHR surface)
   ImGui_ImplVulkanH_CreateOrResizeWindow(m_Instance, m_PhysicalDevice, m_Device, wd, m_QueueFamily, m_Allocator, width, height, m_MinImageCount);
 }
 
+void ImGuiVulkanGlfwApplication::RebuildSwapchain(int width, int height)
+{
+  ImGui_ImplVulkanH_Window* wd = &m_MainWindowData;
+
+  // Every submitted frame and present has finished, the frame fences are
+  // signaled and the semaphores are unsignaled, so all of them are reused
+  VkResult err = vkQueueWaitIdle(m_Queue);
+  check_vk_result(err);
+
+  VkSurfaceCapabilitiesKHR cap;
+  err = vkGetPhysicalDeviceSurfaceCapabilitiesKHR(m_PhysicalDevice, wd->Surface, &cap);
+  check_vk_result(err);
+
+  VkSwapchainCreateInfoKHR info = {};
+  info.sType = VK_STRUCTURE_TYPE_SWAPCHAIN_CREATE_INFO_KHR;
+  info.surface = wd->Surface;
+  info.minImageCount = m_MinImageCount;
+  info.imageFormat = wd->SurfaceFormat.format;
+  info.imageColorSpace = wd->SurfaceFormat.colorSpace;
+  info.imageArrayLayers = 1;
+  info.imageUsage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
+  info.imageSharingMode = VK_SHARING_MODE_EXCLUSIVE;
+  info.compositeAlpha = VK_COMPOSITE_ALPHA_OPAQUE_BIT_KHR;
+  info.presentMode = wd->PresentMode;
+  info.clipped = VK_TRUE;
+  info.oldSwapchain = wd->Swapchain;
+  if (cap.supportedTransforms & VK_SURFACE_TRANSFORM_IDENTITY_BIT_KHR)
+    info.preTransform = VK_SURFACE_TRANSFORM_IDENTITY_BIT_KHR;
+  else
+    info.preTransform = cap.currentTransform;
+  if (info.minImageCount < cap.minImageCount)
+    info.minImageCount = cap.minImageCount;
+  else if (cap.maxImageCount != 0 && info.minImageCount > cap.maxImageCount)
+    info.minImageCount = cap.maxImageCount;
+
+  if (cap.currentExtent.width == 0xffffffff)
+  {
+    info.imageExtent.width = width;
+    info.imageExtent.height = height;
+  }
+  else
+    info.imageExtent = cap.currentExtent;
+
+  // Minimized between the size query and here
+  if (info.imageExtent.width == 0 || info.imageExtent.height == 0)
+    return;
+
+  // The old swapchain is retired by the new one, which may take over its
+  // images
+  VkSwapchainKHR old_swapchain = wd->Swapchain;
+  VkSwapchainKHR swapchain = VK_NULL_HANDLE;
+  err = vkCreateSwapchainKHR(m_Device, &info, m_Allocator, &swapchain);
+  check_vk_result(err);
+
+  uint32_t image_count = 0;
+  err = vkGetSwapchainImagesKHR(m_Device, swapchain, &image_count, NULL);
+  check_vk_result(err);
+
+  if (image_count != wd->ImageCount)
+  {
+    // The per-frame objects (and the renderers sized by the image count)
+    // no longer match, the ImGui helper rebuilds everything, retiring the
+    // swapchain just created
+    wd->Swapchain = swapchain;
+    ImGui_ImplVulkan_SetMinImageCount(m_MinImageCount);
+    ImGui_ImplVulkanH_CreateOrResizeWindow(m_Instance, m_PhysicalDevice, m_Device, wd, m_QueueFamily, m_Allocator, width, height, m_MinImageCount);
+    vkDestroySwapchainKHR(m_Device, old_swapchain, m_Allocator);
+    wd->FrameIndex = 0;
+
+    // Stream buffers and retirement delays are per image in flight
+    GpuFigureRenderer::Instance().SetImageCount(wd->ImageCount);
+    GpuMorphKernel::Instance().SetImageCount(wd->ImageCount);
+    return;
+  }
+
+  // Only the image views and framebuffers refer to the old images, the
+  // render pass, command pools, fences and semaphores are kept
+  for (uint32_t i = 0; i < wd->ImageCount; i++)
+  {
+    ImGui_ImplVulkanH_Frame* fd = &wd->Frames[i];
+    vkDestroyFramebuffer(m_Device, fd->Framebuffer, m_Allocator);
+    vkDestroyImageView(m_Device, fd->BackbufferView, m_Allocator);
+  }
+  vkDestroySwapchainKHR(m_Device, old_swapchain, m_Allocator);
+
+  wd->Swapchain = swapchain;
+  wd->Width = info.imageExtent.width;
+  wd->Height = info.imageExtent.height;
+  wd->FrameIndex = 0;
+
+  VkImage backbuffers[16] = {};
+  IM_ASSERT(image_count <= IM_ARRAYSIZE(backbuffers));
+  err = vkGetSwapchainImagesKHR(m_Device, swapchain, &image_count, backbuffers);
+  check_vk_result(err);
+
+  for (uint32_t i = 0; i < wd->ImageCount; i++)
+  {
+    ImGui_ImplVulkanH_Frame* fd = &wd->Frames[i];
+    fd->Backbuffer = backbuffers[i];
+
+    VkImageViewCreateInfo view_info = {};
+    view_info.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+    view_info.image = fd->Backbuffer;
+    view_info.viewType = VK_IMAGE_VIEW_TYPE_2D;
+    view_info.format = wd->SurfaceFormat.format;
+    view_info.components.r = VK_COMPONENT_SWIZZLE_R;
+    view_info.components.g = VK_COMPONENT_SWIZZLE_G;
+    view_info.components.b = VK_COMPONENT_SWIZZLE_B;
+    view_info.components.a = VK_COMPONENT_SWIZZLE_A;
+    view_info.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    view_info.subresourceRange.baseMipLevel = 0;
+    view_info.subresourceRange.levelCount = 1;
+    view_info.subresourceRange.baseArrayLayer = 0;
+    view_info.subresourceRange.layerCount = 1;
+    err = vkCreateImageView(m_Device, &view_info, m_Allocator, &fd->BackbufferView);
+    check_vk_result(err);
+
+    VkFramebufferCreateInfo fb_info = {};
+    fb_info.sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
+    fb_info.renderPass = wd->RenderPass;
+    fb_info.attachmentCount = 1;
+    fb_info.pAttachments = &fd->BackbufferView;
+    fb_info.width = wd->Width;
+    fb_info.height = wd->Height;
+    fb_info.layers = 1;
+    err = vkCreateFramebuffer(m_Device, &fb_info, m_Allocator, &fd->Framebuffer);
+    check_vk_result(err);
+  }
+}
+
 void ImGuiVulkanGlfwApplication::SetupImGuiContext()
 {
+  auto Fonts = m_FontLoader.Get();
+  m_FontAtlas = std::move(Fonts.Atlas);
+  m_FontsFromCache = Fonts.FromCache;
+
   IMGUI_CHECKVERSION();
-  ImGui::CreateContext();
+  ImGui::CreateContext(m_FontAtlas.get());
   ImGuiIO& io = ImGui::GetIO();
   io.ConfigFlags |= ImGuiConfigFlags_NavEnableKeyboard;       // Enable Keyboard Controls
   //io.ConfigFlags |= ImGuiConfigFlags_NavEnableGamepad;      // Enable Gamepad Controls
@@ -352,9 +618,16 @@ void ImGuiVulkanGlfwApplication::SetupImGuiStyle()
   }
 }
 
-void ImGuiVulkanGlfwApplication::SetupBackends()
+void ImGuiVulkanGlfwApplication::SetupGlfwBackend()
 {
   ImGui_ImplGlfw_InitForVulkan(m_Window, true);
+
+  // On top of the backend's callbacks
+  InputRecorder::Instance().Attach(m_Window);
+}
+
+void ImGuiVulkanGlfwApplication::SetupVulkanBackend()
+{
   ImGui_ImplVulkan_InitInfo init_info = {};
   init_info.Instance = m_Instance;
   init_info.PhysicalDevice = m_PhysicalDevice;
@@ -372,14 +645,56 @@ void ImGuiVulkanGlfwApplication::SetupBackends()
   ImGui_ImplVulkan_Init(&init_info, m_MainWindowData.RenderPass);
 }
 
+void ImGuiVulkanGlfwApplication::SetupGpuFigureRenderer()
+{
+  GpuFigureRenderer::InitInfo info;
+  info.PhysicalDevice = m_PhysicalDevice;
+  info.Device = m_Device;
+  info.RenderPass = m_MainWindowData.RenderPass;
+  info.PipelineCache = m_PipelineCache;
+  info.Allocator = m_Allocator;
+  info.ImageCount = m_MainWindowData.ImageCount;
+  GpuFigureRenderer::Instance().Init(info);
+}
+
+void ImGuiVulkanGlfwApplication::SetupGpuMorphKernel()
+{
+  GpuMorphKernel::InitInfo info;
+  info.PhysicalDevice = m_PhysicalDevice;
+  info.Device = m_Device;
+  info.Queue = m_Queue;
+  info.QueueFamily = m_QueueFamily;
+  info.PipelineCache = m_PipelineCache;
+  info.Allocator = m_Allocator;
+  info.ImageCount = m_MainWindowData.ImageCount;
+  GpuMorphKernel::Instance().Init(info);
+}
+
 void ImGuiVulkanGlfwApplication::UploadFonts()
 {
-  // Use any command queue
-  VkCommandPool command_pool = m_MainWindowData.Frames[m_MainWindowData.FrameIndex].CommandPool;
-  VkCommandBuffer command_buffer = m_MainWindowData.Frames[m_MainWindowData.FrameIndex].CommandBuffer;
+  // Own pool: the frame command buffers are reused before the upload is
+  // known to be finished
+  VkCommandPoolCreateInfo pool_info = {};
+  pool_info.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+  pool_info.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+  pool_info.queueFamilyIndex = m_QueueFamily;
+  auto err = vkCreateCommandPool(m_Device, &pool_info, m_Allocator, &m_FontUploadPool);
+  check_vk_result(err);
+
+  VkCommandBuffer command_buffer = VK_NULL_HANDLE;
+  VkCommandBufferAllocateInfo alloc_info = {};
+  alloc_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+  alloc_info.commandPool = m_FontUploadPool;
+  alloc_info.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+  alloc_info.commandBufferCount = 1;
+  err = vkAllocateCommandBuffers(m_Device, &alloc_info, &command_buffer);
+  check_vk_result(err);
 
-  auto err = vkResetCommandPool(m_Device, command_pool, 0);
+  VkFenceCreateInfo fence_info = {};
+  fence_info.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+  err = vkCreateFence(m_Device, &fence_info, m_Allocator, &m_FontUploadFence);
   check_vk_result(err);
+
   VkCommandBufferBeginInfo begin_info = {};
   begin_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
   begin_info.flags |= VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
@@ -394,12 +709,31 @@ void ImGuiVulkanGlfwApplication::UploadFonts()
   end_info.pCommandBuffers = &command_buffer;
   err = vkEndCommandBuffer(command_buffer);
   check_vk_result(err);
-  err = vkQueueSubmit(m_Queue, 1, &end_info, VK_NULL_HANDLE);
+  err = vkQueueSubmit(m_Queue, 1, &end_info, m_FontUploadFence);
   check_vk_result(err);
 
-  err = vkDeviceWaitIdle(m_Device);
-  check_vk_result(err);
+  // No wait here: frames are submitted to the same queue after the upload,
+  // whose barrier makes the texture visible to their fragment shaders.
+  // Only the staging buffer has to outlive it, see FinishFontUpload()
+}
+
+void ImGuiVulkanGlfwApplication::FinishFontUpload()
+{
+  if (!m_FontUploadFence || vkGetFenceStatus(m_Device, m_FontUploadFence) != VK_SUCCESS)
+    return;
+
   ImGui_ImplVulkan_DestroyFontUploadObjects();
+  vkDestroyFence(m_Device, m_FontUploadFence, m_Allocator);
+  vkDestroyCommandPool(m_Device, m_FontUploadPool, m_Allocator);
+  m_FontUploadFence = VK_NULL_HANDLE;
+  m_FontUploadPool = VK_NULL_HANDLE;
+}
+
+void ImGuiVulkanGlfwApplication::ReportStartup()
+{
+  std::cout << (m_FontsFromCache ? "Warm" : "Cold") << " start (font atlas "
+            << (m_FontsFromCache ? "from cache" : "rasterized") << ")\n";
+  StartupTrace::Instance().Print(std::cout);
 }
 
 bool ImGuiVulkanGlfwApplication::FrameRender()
@@ -415,12 +749,17 @@ bool ImGuiVulkanGlfwApplication::FrameRender()
   VkSemaphore render_complete_semaphore = m_MainWindowData.FrameSemaphores[m_MainWindowData.SemaphoreIndex].RenderCompleteSemaphore;
   {
     const auto err = vkAcquireNextImageKHR(m_Device, m_MainWindowData.Swapchain, UINT64_MAX, image_acquired_semaphore, VK_NULL_HANDLE, &m_MainWindowData.FrameIndex);
-    if (err == VK_ERROR_OUT_OF_DATE_KHR || err == VK_SUBOPTIMAL_KHR)
+    if (err == VK_ERROR_OUT_OF_DATE_KHR)
     {
       m_SwapChainRebuild = true;
       return false;
     }
-    check_vk_result(err);
+    // The image is acquired and its semaphore signaled, the frame is
+    // rendered and the rebuild waits for the resize to settle
+    if (err == VK_SUBOPTIMAL_KHR)
+      m_SwapChainSuboptimal = true;
+    else
+      check_vk_result(err);
   }
 
   ImGui_ImplVulkanH_Frame* fd = &m_MainWindowData.Frames[m_MainWindowData.FrameIndex];
@@ -440,6 +779,13 @@ bool ImGuiVulkanGlfwApplication::FrameRender()
     err = vkBeginCommandBuffer(fd->CommandBuffer, &info);
     check_vk_result(err);
   }
+
+  // Figure callbacks in the draw data record into this command buffer
+  GpuFigureRenderer::Instance().BeginFrame(fd->CommandBuffer, main_draw_data);
+
+  // Compute dispatches can not be recorded inside the render pass, the
+  // outlines they write are drawn by the figure callbacks above
+  GpuMorphKernel::Instance().BeginFrame(fd->CommandBuffer);
   {
     VkRenderPassBeginInfo info = {};
     info.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
@@ -492,12 +838,15 @@ void ImGuiVulkanGlfwApplication::FramePresent()
   info.pSwapchains = &m_MainWindowData.Swapchain;
   info.pImageIndices = &m_MainWindowData.FrameIndex;
   VkResult err = vkQueuePresentKHR(m_Queue, &info);
-  if (err == VK_ERROR_OUT_OF_DATE_KHR || err == VK_SUBOPTIMAL_KHR)
+  if (err == VK_ERROR_OUT_OF_DATE_KHR)
   {
     m_SwapChainRebuild = true;
     return;
   }
-  check_vk_result(err);
+  if (err == VK_SUBOPTIMAL_KHR)
+    m_SwapChainSuboptimal = true;
+  else
+    check_vk_result(err);
   m_MainWindowData.SemaphoreIndex = (m_MainWindowData.SemaphoreIndex + 1) % m_MainWindowData.ImageCount; // Now we can use the next set of semaphores
 }
 
@@ -534,22 +883,22 @@ void ImGuiVulkanGlfwApplication::ShowDockSpace()
 
     std::vector<ImGuiID> ids;
 
-    const float ratio = 1.0f / m_Windows.size();
+    const float ratio = 1.0f / m_Windows.GetSize();
 
-    for (int i = 0; i < m_Windows.size(); ++i)
+    for (int i = 0; i < m_Windows.GetSize(); ++i)
     {
-      if (i == m_Windows.size() - 1)
+      if (i == m_Windows.GetSize() - 1)
         ids.push_back(DockMainID);
       else
-      if (i == m_Windows.size() - 2)
+      if (i == m_Windows.GetSize() - 2)
         ids.push_back(ImGui::DockBuilderSplitNode(DockMainID, ImGuiDir_Left, 0.5f, nullptr, &DockMainID));
       else
         ids.push_back(ImGui::DockBuilderSplitNode(DockMainID, ImGuiDir_Left, ratio, nullptr, &DockMainID));
     }
 
-    for (int i = 0; i < m_Windows.size(); ++i)
+    for (int i = 0; i < m_Windows.GetSize(); ++i)
     {
-      ImGui::DockBuilderDockWindow(m_Windows[i]->GetWindowNameID().c_str(), ids[i]);
+      ImGui::DockBuilderDockWindow(m_Windows.GetLabel(i), ids[i]);
     }
 
     ImGui::DockBuilderFinish(dockspace_id);
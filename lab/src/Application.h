@@ -1,6 +1,10 @@
 #pragma once
 
 #include "IWindow.h"
+#include "WindowRegistry.h"
+#include "FontAtlasCache.h"
+#include "ResizeMonitor.h"
+#include "FrameArena.h"
 
 #include "imgui.h"
 #include "imgui_impl_glfw.h"
@@ -16,6 +20,7 @@
 
 #include <vector>
 #include <memory>
+#include <string>
 
 class ImGuiVulkanGlfwApplication
 {
@@ -23,6 +28,17 @@ public: // Interface
 
   void Run();
 
+  // Input session, see InputRecorder. Must be called before Run()
+  void RecordInput(
+      const std::string & path
+    );
+
+  // Headless replays run in a hidden window and exit at the end of the log
+  void ReplayInput(
+      const std::string & path,
+      const bool          headless
+    );
+
   void AddWindow(
       std::shared_ptr<IWindow> && window
     );
@@ -37,7 +53,10 @@ private: // Service
   void MainLoop();
   void Cleanup();
 
-  void SetupGlfwWindow();
+  void PollEvents();
+
+  void InitGlfw();
+  void CreateGlfwWindow();
   void SetupVulkan();
   void CreateVulkanInstance();
   void SelectGPU();
@@ -46,10 +65,16 @@ private: // Service
   void CreateDescriptorPool();
   VkSurfaceKHR CreateWindowSurface();
   void CreateFramebuffers(VkSurfaceKHR surface);
+  void RebuildSwapchain(int width, int height);
   void SetupImGuiContext();
   void SetupImGuiStyle();
-  void SetupBackends();
+  void SetupGlfwBackend();
+  void SetupVulkanBackend();
+  void SetupGpuFigureRenderer();
+  void SetupGpuMorphKernel();
   void UploadFonts();
+  void FinishFontUpload();
+  void ReportStartup();
   bool FrameRender();
   void FramePresent();
   void ShowDockSpace();
@@ -76,22 +101,51 @@ private: // Static service
 
 private:
 
-  VkAllocationCallbacks *  m_Allocator         = nullptr;
-  VkInstance               m_Instance          = VK_NULL_HANDLE;
-  VkPhysicalDevice         m_PhysicalDevice    = VK_NULL_HANDLE;
-  VkDevice                 m_Device            = VK_NULL_HANDLE;
-  uint32_t                 m_QueueFamily       = (uint32_t)-1;
-  VkQueue                  m_Queue             = VK_NULL_HANDLE;
-  VkDebugReportCallbackEXT m_DebugReport       = VK_NULL_HANDLE;
-  VkPipelineCache          m_PipelineCache     = VK_NULL_HANDLE;
-  VkDescriptorPool         m_DescriptorPool    = VK_NULL_HANDLE;
+  VkAllocationCallbacks *  m_Allocator           = nullptr;
+  VkInstance               m_Instance            = VK_NULL_HANDLE;
+  VkPhysicalDevice         m_PhysicalDevice      = VK_NULL_HANDLE;
+  VkDevice                 m_Device              = VK_NULL_HANDLE;
+  uint32_t                 m_QueueFamily         = (uint32_t)-1;
+  VkQueue                  m_Queue               = VK_NULL_HANDLE;
+  VkDebugReportCallbackEXT m_DebugReport         = VK_NULL_HANDLE;
+  VkPipelineCache          m_PipelineCache       = VK_NULL_HANDLE;
+  VkDescriptorPool         m_DescriptorPool      = VK_NULL_HANDLE;
   ImGui_ImplVulkanH_Window m_MainWindowData;
-  int                      m_MinImageCount     = 2;
-  bool                     m_SwapChainRebuild  = false;
-  bool                     m_NeedDefaultLayout = true;
+  int                      m_MinImageCount       = 2;
+  bool                     m_SwapChainRebuild    = false;
+  bool                     m_SwapChainSuboptimal = false;
+  ResizeMonitor            m_Resize;
+  bool                     m_NeedDefaultLayout   = true;
+
+  GLFWwindow * m_Window     = nullptr;
+  bool         m_IsReplay   = false;
+  bool         m_IsHeadless = false;
+
+  // The atlas is built on a worker during Init() and shared with the
+  // ImGui context, the upload is finished by polling its fence
+  FontAtlasLoader              m_FontLoader;
+  std::unique_ptr<ImFontAtlas> m_FontAtlas;
+  VkCommandPool                m_FontUploadPool  = VK_NULL_HANDLE;
+  VkFence                      m_FontUploadFence = VK_NULL_HANDLE;
+
+  // Startup report, see StartupTrace
+  bool                         m_FontsFromCache  = false;
+  bool                         m_IsFirstFrame    = true;
+
+  // Geometry temporaries of the current frame, reset every iteration
+  FrameArena                   m_FrameArena;
+
+  WindowRegistry               m_Windows;
+
+  // Frames left before an idle loop sleeps again, see PollEvents()
+  int                          m_SettleFrames    = 0;
+
+private: // Constants
 
-  GLFWwindow * m_Window = nullptr;
+  // Longest sleep of an idle main loop, seconds
+  static constexpr double IDLE_WAIT_TIMEOUT  = 0.1;
 
-  std::vector<std::shared_ptr<IWindow>> m_Windows;
+  // Frames drawn after an event wakes an idle loop
+  static constexpr int    IDLE_SETTLE_FRAMES = 3;
 };
 
@@ -0,0 +1,251 @@
+#include "BezierTessellation.h"
+#include "ThreadPool.h"
+#include "GpuFigureRenderer.h"
+
+#include <algorithm>
+
+//
+// Interface
+//
+
+void BezierTessellation::Reset()
+{
+  m_Samples.Clear();
+  m_Boxes.clear();
+  m_Blocks.clear();
+  m_Dirty.clear();
+}
+
+void BezierTessellation::Invalidate(
+    const std::size_t index
+  )
+{
+  const auto Segment = index / 3;
+
+  // An anchor ends the segment before it and starts the one after it
+  if (index % 3 == 0 && Segment > 0)
+    m_Dirty.push_back(Segment - 1);
+
+  m_Dirty.push_back(Segment);
+}
+
+void BezierTessellation::Update(
+    const FigureView points
+  )
+{
+  const auto Segments = points.Size() >= 4 ? (points.Size() - 1) / 3 : 0;
+  const auto Cached = std::min(m_Boxes.size(), Segments);
+  const bool IsResized = Segments != m_Boxes.size();
+
+  for (auto i = Cached; i < Segments; ++i)
+    m_Dirty.push_back(i);
+
+  m_Boxes.resize(Segments);
+  m_Samples.Resize(Segments ? Segments * SEGMENT_SAMPLES + 1 : 0);
+
+  // A segment is tessellated once even when several of its points moved,
+  // segments past the end were removed since they were invalidated
+  std::sort(m_Dirty.begin(), m_Dirty.end());
+  m_Dirty.erase(std::unique(m_Dirty.begin(), m_Dirty.end()), m_Dirty.end());
+  m_Dirty.erase(std::lower_bound(m_Dirty.begin(), m_Dirty.end(), Segments), m_Dirty.end());
+
+  const auto Run = [&](const std::size_t begin, const std::size_t end)
+  {
+    for (std::size_t i = begin; i < end; ++i)
+      Tessellate(points, m_Dirty[i]);
+  };
+
+  if (m_Dirty.size() < PARALLEL_SPLINE_THRESHOLD)
+    Run(0, m_Dirty.size());
+  else
+    ThreadPool::Instance().ParallelFor(0, m_Dirty.size(), PARALLEL_SPLINE_GRAIN, Run);
+
+  if (IsResized || !m_Dirty.empty())
+    UpdateBlocks(IsResized, m_Dirty);
+
+  m_Dirty.clear();
+
+  if (Segments)
+    m_Samples.Set(Segments * SEGMENT_SAMPLES, points[Segments * 3]);
+}
+
+std::size_t BezierTessellation::GetSegmentCount() const
+{
+  return m_Boxes.size();
+}
+
+const BoundingBox & BezierTessellation::GetBounds(
+    const std::size_t segment
+  ) const
+{
+  return m_Boxes[segment];
+}
+
+void BezierTessellation::FindSegments(
+    const ImVec2                                          min,
+    const ImVec2                                          max,
+    const float                                           min_size,
+    const std::function<void(std::size_t, std::size_t)> & visit
+  ) const
+{
+  if (m_Boxes.empty())
+    return;
+
+  std::size_t First = 0, Last = 0;
+
+  // Depth first over the levels, so the segments come out in path order.
+  // Level 0 are the segment boxes, level k + 1 is m_Blocks[k]. A box
+  // contains every box below it, so a miss or a box smaller than
+  // `min_size` rules out the whole subtree.
+  const auto Visit = [&](const auto & self, const std::size_t level, const std::size_t index) -> void
+  {
+    const auto & Box = GetBox(level, index);
+
+    if (!Box.Intersects(min, max) || std::max(Box.Max.x - Box.Min.x, Box.Max.y - Box.Min.y) < min_size)
+      return;
+
+    if (level == 0)
+    {
+      if (index != Last)
+      {
+        if (First != Last)
+          visit(First, Last);
+
+        First = index;
+      }
+
+      Last = index + 1;
+      return;
+    }
+
+    const auto Count = level == 1 ? m_Boxes.size() : m_Blocks[level - 2].size();
+    const auto End = std::min((index + 1) * BLOCK_SEGMENTS, Count);
+
+    for (auto i = index * BLOCK_SEGMENTS; i < End; ++i)
+      self(self, level - 1, i);
+  };
+
+  Visit(Visit, m_Blocks.size(), 0);
+
+  if (First != Last)
+    visit(First, Last);
+}
+
+void BezierTessellation::Draw(
+    const ImVec2 pos,
+    const ImU32  col,
+    const float  thickness,
+    const float  scale
+  ) const
+{
+  const auto * DrawList = ImGui::GetWindowDrawList();
+
+  const auto Margin = ImVec2{ thickness, thickness };
+  const auto ClipMin = (DrawList->GetClipRectMin() - pos - Margin) / scale;
+  const auto ClipMax = (DrawList->GetClipRectMax() - pos + Margin) / scale;
+
+  // A run of visible segments ends with the first sample of the segment
+  // after it, the last segment with the final anchor
+  FindSegments(ClipMin, ClipMax, 0, [&](const std::size_t first, const std::size_t last)
+  {
+    const auto Begin = first * SEGMENT_SAMPLES;
+    DrawCurve(FigureView(m_Samples.X() + Begin, m_Samples.Y() + Begin, (last - first) * SEGMENT_SAMPLES + 1), pos, col, thickness, scale);
+  });
+}
+
+//
+// Service
+//
+
+void BezierTessellation::Tessellate(
+    const FigureView  points,
+    const std::size_t segment
+  )
+{
+  const auto P1 = points[segment * 3];
+  const auto V1 = points[segment * 3 + 1];
+  const auto V2 = points[segment * 3 + 2];
+  const auto P2 = points[segment * 3 + 3];
+
+  BoundingBox Box;
+
+  for (const auto & Point : { P1, V1, V2, P2 })
+    Box.Add(Point);
+
+  m_Boxes[segment] = Box;
+
+  auto * X = m_Samples.X() + segment * SEGMENT_SAMPLES;
+  auto * Y = m_Samples.Y() + segment * SEGMENT_SAMPLES;
+
+  for (std::size_t k = 0; k < SEGMENT_SAMPLES; ++k)
+  {
+    const auto Point = BezierInterpolate(P1, P2, V1, V2, float(k) / SEGMENT_SAMPLES);
+    X[k] = Point.x;
+    Y[k] = Point.y;
+  }
+}
+
+void BezierTessellation::UpdateBlocks(
+    const bool                       is_resized,
+    const std::vector<std::size_t> & segments
+  )
+{
+  // Appending a segment is rare next to moving a handle, the hierarchy is
+  // just built again then, at 1 / (BLOCK_SEGMENTS - 1) boxes per segment
+  if (is_resized)
+  {
+    m_Blocks.clear();
+
+    for (auto Count = m_Boxes.size(); Count > 1;)
+    {
+      Count = (Count + BLOCK_SEGMENTS - 1) / BLOCK_SEGMENTS;
+      m_Blocks.emplace_back(Count);
+    }
+  }
+
+  std::vector<std::size_t> Changed = segments;
+
+  for (std::size_t Level = 0; Level < m_Blocks.size(); ++Level)
+  {
+    auto & Blocks = m_Blocks[Level];
+    const auto ChildCount = Level == 0 ? m_Boxes.size() : m_Blocks[Level - 1].size();
+
+    if (is_resized)
+    {
+      Changed.resize(Blocks.size());
+
+      for (std::size_t i = 0; i < Changed.size(); ++i)
+        Changed[i] = i;
+    }
+    else
+    {
+      for (auto & Index : Changed)
+        Index /= BLOCK_SEGMENTS;
+
+      Changed.erase(std::unique(Changed.begin(), Changed.end()), Changed.end());
+    }
+
+    for (const auto Block : Changed)
+    {
+      BoundingBox Box;
+      const auto End = std::min((Block + 1) * BLOCK_SEGMENTS, ChildCount);
+
+      for (auto i = Block * BLOCK_SEGMENTS; i < End; ++i)
+      {
+        const auto & Child = GetBox(Level, i);
+        Box.Add(Child.Min);
+        Box.Add(Child.Max);
+      }
+
+      Blocks[Block] = Box;
+    }
+  }
+}
+
+const BoundingBox & BezierTessellation::GetBox(
+    const std::size_t level,
+    const std::size_t index
+  ) const
+{
+  return level == 0 ? m_Boxes[index] : m_Blocks[level - 1][index];
+}
@@ -0,0 +1,100 @@
+#pragma once
+
+#include "FigureView.h"
+#include "FigureBuffer.h"
+#include "ImVecUtils.h"
+
+#include <vector>
+#include <functional>
+#include <cstddef>
+
+//
+// Cached tessellation of a cubic Bezier path. The path is one figure of
+// anchors with two control handles between each pair,
+//
+//   A0 C C A1 C C A2 ...
+//
+// so segment s uses points 3s to 3s + 3. Every segment keeps its samples
+// and the bounding box of its control hull, which contains the curve.
+// Moving a handle invalidates only the segments it belongs to, Update()
+// re-tessellates just those and the segments appended since.
+//
+// Runs of BLOCK_SEGMENTS consecutive boxes are grouped into blocks, and
+// blocks into blocks of blocks up to a single root, so visibility queries
+// skip whole offscreen parts of the path. A moved handle refreshes only
+// the blocks above its segments.
+//
+
+class BezierTessellation
+{
+public: // Constants
+
+  static constexpr std::size_t SEGMENT_SAMPLES = 24;
+  static constexpr std::size_t BLOCK_SEGMENTS  = 16;
+
+public: // Interface
+
+  // Drops the cache, call when the points are replaced
+  void Reset();
+
+  // Marks the segments that use point `index` of the path
+  void Invalidate(
+      const std::size_t index
+    );
+
+  void Update(
+      const FigureView points
+    );
+
+  std::size_t GetSegmentCount() const;
+
+  const BoundingBox & GetBounds(
+      const std::size_t segment
+    ) const;
+
+  // Calls `visit(first, last)` for the runs of consecutive segments
+  // [first, last) whose boxes intersect the rectangle and whose larger
+  // side is at least `min_size`, in path order
+  void FindSegments(
+      const ImVec2                                          min,
+      const ImVec2                                          max,
+      const float                                           min_size,
+      const std::function<void(std::size_t, std::size_t)> & visit
+    ) const;
+
+  // Segments whose boxes miss the clip rect of the current window are not
+  // emitted, the visible runs are drawn straight from the cache
+  void Draw(
+      const ImVec2 pos,
+      const ImU32  col = 0xFFFFFFFF,
+      const float  thickness = 1,
+      const float  scale = 1
+    ) const;
+
+private: // Service
+
+  void Tessellate(
+      const FigureView  points,
+      const std::size_t segment
+    );
+
+  // Refreshes the blocks above the sorted `segments`, or every block when
+  // the number of segments changed
+  void UpdateBlocks(
+      const bool                       is_resized,
+      const std::vector<std::size_t> & segments
+    );
+
+  const BoundingBox & GetBox(
+      const std::size_t level,
+      const std::size_t index
+    ) const;
+
+private: // Members
+
+  FigureBuffer                          m_Samples;
+  std::vector<BoundingBox>              m_Boxes;
+  // m_Blocks[0] groups the boxes, every next level the blocks below it
+  std::vector<std::vector<BoundingBox>> m_Blocks;
+  std::vector<std::size_t>              m_Dirty;
+};
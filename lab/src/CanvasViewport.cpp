@@ -0,0 +1,64 @@
+#include "CanvasViewport.h"
+
+#include "ImVecUtils.h"
+
+#include <algorithm>
+
+//
+// Interface
+//
+
+void CanvasViewport::Begin()
+{
+  ImGui::BeginChild("Viewport", ImVec2(-1, -1), true, ImGuiWindowFlags_NoScrollbar | ImGuiWindowFlags_NoScrollWithMouse);
+
+  const auto CursorPos = ImGui::GetCursorScreenPos();
+
+  if (ImGui::IsWindowHovered())
+  {
+    const auto & IO = ImGui::GetIO();
+
+    if (ImGui::IsMouseDown(ImGuiMouseButton_Right) || ImGui::IsMouseDown(ImGuiMouseButton_Middle))
+      m_Pan = m_Pan + IO.MouseDelta;
+
+    if (IO.MouseWheel != 0)
+    {
+      // Keep the canvas point under the cursor in place
+      const auto Anchor = (IO.MousePos - CursorPos - m_Pan) / m_Zoom;
+
+      m_Zoom = std::clamp(m_Zoom * std::pow(ZOOM_STEP, IO.MouseWheel), MIN_ZOOM, MAX_ZOOM);
+      m_Pan = IO.MousePos - CursorPos - Anchor * m_Zoom;
+    }
+  }
+
+  m_Origin = CursorPos + m_Pan;
+}
+
+void CanvasViewport::End()
+{
+  ImGui::EndChild();
+}
+
+ImVec2 CanvasViewport::GetOrigin() const
+{
+  return m_Origin;
+}
+
+float CanvasViewport::GetZoom() const
+{
+  return m_Zoom;
+}
+
+ImVec2 CanvasViewport::ToCanvas(
+    const ImVec2 screen
+  ) const
+{
+  return (screen - m_Origin) / m_Zoom;
+}
+
+ImVec2 CanvasViewport::ToScreen(
+    const ImVec2 canvas
+  ) const
+{
+  return m_Origin + canvas * m_Zoom;
+}
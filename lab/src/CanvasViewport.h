@@ -0,0 +1,44 @@
+#pragma once
+
+#include <imgui.h>
+
+//
+// Pan/zoom canvas shared by the windows that draw figures. Figures live in
+// canvas coordinates, the viewport maps them to the screen: the right or
+// middle mouse button pans, the wheel zooms around the cursor.
+//
+
+class CanvasViewport
+{
+public: // Interface
+
+  // Begins the "Viewport" child window and applies this frame's pan/zoom input
+  void Begin();
+
+  void End();
+
+  // Screen position of the canvas origin
+  ImVec2 GetOrigin() const;
+
+  float GetZoom() const;
+
+  ImVec2 ToCanvas(
+      const ImVec2 screen
+    ) const;
+
+  ImVec2 ToScreen(
+      const ImVec2 canvas
+    ) const;
+
+private: // Constants
+
+  static constexpr float MIN_ZOOM  = 1.f / 64;
+  static constexpr float MAX_ZOOM  = 64.f;
+  static constexpr float ZOOM_STEP = 1.2f;
+
+private: // Members
+
+  ImVec2 m_Pan{ 0, 0 };
+  float  m_Zoom = 1;
+  ImVec2 m_Origin{ 0, 0 };
+};
@@ -0,0 +1,486 @@
+#include "Correspondence.h"
+
+#include "ImVecUtils.h"
+
+#include <algorithm>
+#include <limits>
+#include <cmath>
+
+namespace
+{
+
+constexpr float INF = std::numeric_limits<float>::infinity();
+
+using Path = std::vector<std::pair<std::size_t, std::size_t>>;
+
+// Half-open range of columns, relative to the left edge of a subproblem
+using Span = std::pair<std::size_t, std::size_t>;
+
+std::vector<ImVec2> GetTangents(
+    const FigureView points
+  )
+{
+  std::vector<ImVec2> Result(points.Size(), ImVec2{ 0, 0 });
+
+  for (std::size_t i = 0; i < points.Size(); ++i)
+  {
+    const auto d = points[std::min(i + 1, points.Size() - 1)] - points[i > 0 ? i - 1 : 0];
+    const auto Length = std::sqrt(d * d);
+
+    if (Length > 0)
+      Result[i] = d / Length;
+  }
+
+  return Result;
+}
+
+class DtwSolver
+{
+public: // Construction
+
+  DtwSolver(
+      const FigureView   first,
+      const FigureView   second,
+      const DtwOptions & options
+    ) :
+      m_First(first),
+      m_Second(second),
+      m_FirstTangents(GetTangents(first)),
+      m_SecondTangents(GetTangents(second)),
+      m_TangentWeight(options.TangentWeight)
+  {
+    const auto n = first.Size();
+    const auto m = second.Size();
+
+    // The band follows the scaled diagonal and has to be at least as wide as
+    // its slope, otherwise consecutive rows would not overlap
+    const auto Slope = n > 1 ? std::size_t(std::ceil(double(m - 1) / (n - 1))) : m;
+    m_Band = std::max<std::size_t>(std::size_t(options.BandRatio * std::max(n, m)), Slope + 1);
+  }
+
+public: // Interface
+
+  Path Solve()
+  {
+    Path Result;
+    Result.reserve(m_First.Size() + m_Second.Size());
+    Solve(0, m_First.Size() - 1, 0, m_Second.Size() - 1, Result);
+    return Result;
+  }
+
+private: // Service
+
+  std::size_t Low(std::size_t i) const
+  {
+    const auto Center = Diagonal(i);
+    return Center > m_Band ? Center - m_Band : 0;
+  }
+
+  std::size_t High(std::size_t i) const
+  {
+    return std::min(Diagonal(i) + m_Band, m_Second.Size() - 1);
+  }
+
+  std::size_t Diagonal(std::size_t i) const
+  {
+    if (m_First.Size() < 2)
+      return 0;
+
+    return std::size_t(double(i) * (m_Second.Size() - 1) / (m_First.Size() - 1) + 0.5);
+  }
+
+  float Cost(std::size_t i, std::size_t j) const
+  {
+    const auto TangentCost = 1 - m_FirstTangents[i] * m_SecondTangents[j];
+    return ImVecDistance(m_First[i], m_Second[j]) + m_TangentWeight * TangentCost;
+  }
+
+  // Cost of the best path from (i0, j0) to every cell of row `last` within
+  // columns [j0, j1], indexed by j - j0
+  std::vector<float> Forward(
+      std::size_t i0,
+      std::size_t last,
+      std::size_t j0,
+      std::size_t j1
+    ) const
+  {
+    const auto Cols = j1 - j0 + 1;
+    std::vector<float> Previous(Cols, INF), Current(Cols, INF);
+
+    // A row only writes its band, so clearing what the row two steps back
+    // wrote keeps every other cell at INF and a row costs O(w), not O(Cols)
+    Span PreviousSpan{ 0, 0 }, CurrentSpan{ 0, 0 };
+
+    for (auto i = i0; i <= last; ++i)
+    {
+      std::fill(Current.begin() + CurrentSpan.first, Current.begin() + CurrentSpan.second, INF);
+
+      const auto From = std::max(j0, Low(i));
+      const auto To = std::min(j1, High(i));
+
+      for (auto j = From; j <= To; ++j)
+      {
+        const auto k = j - j0;
+
+        float Best = INF;
+
+        if (i == i0 && j == j0)
+          Best = 0;
+
+        if (i > i0)
+          Best = std::min(Best, Previous[k]);
+
+        if (k > 0)
+        {
+          Best = std::min(Best, Current[k - 1]);
+
+          if (i > i0)
+            Best = std::min(Best, Previous[k - 1]);
+        }
+
+        if (Best < INF)
+          Current[k] = Best + Cost(i, j);
+      }
+
+      CurrentSpan = From <= To ? Span{ From - j0, To - j0 + 1 } : Span{ 0, 0 };
+
+      std::swap(Previous, Current);
+      std::swap(PreviousSpan, CurrentSpan);
+    }
+
+    return Previous;
+  }
+
+  // Cost of the best path from every cell of row `first` within columns
+  // [j0, j1] to (i1, j1), indexed by j - j0
+  std::vector<float> Backward(
+      std::size_t first,
+      std::size_t i1,
+      std::size_t j0,
+      std::size_t j1
+    ) const
+  {
+    const auto Cols = j1 - j0 + 1;
+    std::vector<float> Next(Cols, INF), Current(Cols, INF);
+
+    // Same reset as in Forward()
+    Span NextSpan{ 0, 0 }, CurrentSpan{ 0, 0 };
+
+    for (auto i = i1 + 1; i-- > first;)
+    {
+      std::fill(Current.begin() + CurrentSpan.first, Current.begin() + CurrentSpan.second, INF);
+
+      const auto From = std::max(j0, Low(i));
+      const auto To = std::min(j1, High(i));
+
+      for (auto j = To + 1; j-- > From;)
+      {
+        const auto k = j - j0;
+
+        float Best = INF;
+
+        if (i == i1 && j == j1)
+          Best = 0;
+
+        if (i < i1)
+          Best = std::min(Best, Next[k]);
+
+        if (k + 1 < Cols)
+        {
+          Best = std::min(Best, Current[k + 1]);
+
+          if (i < i1)
+            Best = std::min(Best, Next[k + 1]);
+        }
+
+        if (Best < INF)
+          Current[k] = Best + Cost(i, j);
+      }
+
+      CurrentSpan = From <= To ? Span{ From - j0, To - j0 + 1 } : Span{ 0, 0 };
+
+      std::swap(Next, Current);
+      std::swap(NextSpan, CurrentSpan);
+    }
+
+    return Next;
+  }
+
+  // Appends the best path from (i0, j0) to (i1, j1), both ends included
+  void Solve(
+      std::size_t i0,
+      std::size_t i1,
+      std::size_t j0,
+      std::size_t j1,
+      Path &      path
+    ) const
+  {
+    if (i1 - i0 < 2)
+    {
+      SolveSmall(i0, i1, j0, j1, path);
+      return;
+    }
+
+    const auto Middle = (i0 + i1) / 2;
+
+    std::size_t SplitFirst = j0, SplitSecond = j0;
+
+    {
+      const auto Head = Forward(i0, Middle, j0, j1);
+      const auto Tail = Backward(Middle + 1, i1, j0, j1);
+
+      float Best = INF;
+
+      // The path leaves the middle row with a vertical or diagonal step
+      for (std::size_t k = 0; k < Head.size(); ++k)
+      {
+        if (Head[k] == INF)
+          continue;
+
+        for (const auto Step : { std::size_t(0), std::size_t(1) })
+        {
+          if (k + Step < Tail.size() && Head[k] + Tail[k + Step] < Best)
+          {
+            Best = Head[k] + Tail[k + Step];
+            SplitFirst = j0 + k;
+            SplitSecond = j0 + k + Step;
+          }
+        }
+      }
+    }
+
+    Solve(i0, Middle, j0, SplitFirst, path);
+    Solve(Middle + 1, i1, SplitSecond, j1, path);
+  }
+
+  // One or two rows: keep the cost table of their bands and backtrack
+  // through it
+  void SolveSmall(
+      std::size_t i0,
+      std::size_t i1,
+      std::size_t j0,
+      std::size_t j1,
+      Path &      path
+    ) const
+  {
+    const auto Rows = i1 - i0 + 1;
+
+    // Row r keeps its band of columns at Offsets[r], cells outside of it
+    // read as INF
+    std::vector<Span> Bands(Rows);
+    std::vector<std::size_t> Offsets(Rows + 1, 0);
+
+    for (std::size_t r = 0; r < Rows; ++r)
+    {
+      const auto From = std::max(j0, Low(i0 + r));
+      const auto To = std::min(j1, High(i0 + r));
+
+      Bands[r] = From <= To ? Span{ From, To + 1 } : Span{ From, From };
+      Offsets[r + 1] = Offsets[r] + Bands[r].second - Bands[r].first;
+    }
+
+    std::vector<float> Table(Offsets[Rows], INF);
+
+    const auto At = [&](std::size_t r, std::size_t j) -> float
+    {
+      if (j < Bands[r].first || j >= Bands[r].second)
+        return INF;
+
+      return Table[Offsets[r] + j - Bands[r].first];
+    };
+
+    for (std::size_t r = 0; r < Rows; ++r)
+    {
+      const auto i = i0 + r;
+
+      for (auto j = Bands[r].first; j < Bands[r].second; ++j)
+      {
+        float Best = (r == 0 && j == j0) ? 0 : INF;
+
+        if (r > 0)
+          Best = std::min(Best, At(r - 1, j));
+
+        if (j > j0)
+        {
+          Best = std::min(Best, At(r, j - 1));
+
+          if (r > 0)
+            Best = std::min(Best, At(r - 1, j - 1));
+        }
+
+        if (Best < INF)
+          Table[Offsets[r] + j - Bands[r].first] = Best + Cost(i, j);
+      }
+    }
+
+    const auto Start = path.size();
+
+    std::size_t r = Rows - 1, j = j1;
+    path.push_back({ i0 + r, j });
+
+    while (r > 0 || j > j0)
+    {
+      auto NextR = r, NextJ = j;
+      float Best = INF;
+
+      const auto Consider = [&](std::size_t rr, std::size_t jj)
+      {
+        if (At(rr, jj) < Best)
+        {
+          Best = At(rr, jj);
+          NextR = rr;
+          NextJ = jj;
+        }
+      };
+
+      if (r > 0 && j > j0)
+        Consider(r - 1, j - 1);
+
+      if (r > 0)
+        Consider(r - 1, j);
+
+      if (j > j0)
+        Consider(r, j - 1);
+
+      // Unreachable end, can only happen with a degenerate band
+      if (Best == INF)
+        NextR = r > 0 ? r - 1 : r, NextJ = j > j0 ? j - 1 : j;
+
+      r = NextR;
+      j = NextJ;
+      path.push_back({ i0 + r, j });
+    }
+
+    std::reverse(path.begin() + Start, path.end());
+  }
+
+private: // Members
+
+  FigureView          m_First;
+  FigureView          m_Second;
+  std::vector<ImVec2> m_FirstTangents;
+  std::vector<ImVec2> m_SecondTangents;
+  float               m_TangentWeight = 0;
+  std::size_t         m_Band = 1;
+};
+
+// Points of `figure` along the path. A point matched to a run of k points of
+// the other figure is spread over its segment to the next point (the last
+// point over what is left of the incoming segment), so the morph never gets
+// coincident neighbours.
+std::vector<ImVec2> Resample(
+    const FigureView figure,
+    const Path &     path,
+    const bool       use_first
+  )
+{
+  std::vector<ImVec2> Result;
+  Result.reserve(path.size());
+
+  const auto Index = [&](std::size_t k) { return use_first ? path[k].first : path[k].second; };
+
+  std::size_t PreviousRunLength = 1;
+
+  for (std::size_t k = 0; k < path.size();)
+  {
+    const auto i = Index(k);
+
+    auto RunEnd = k;
+
+    while (RunEnd < path.size() && Index(RunEnd) == i)
+      ++RunEnd;
+
+    const auto RunLength = RunEnd - k;
+
+    for (std::size_t r = 0; r < RunLength; ++r)
+    {
+      if (RunLength == 1 || figure.Size() == 1)
+      {
+        Result.push_back(figure[i]);
+      }
+      else
+      if (i + 1 < figure.Size())
+      {
+        Result.push_back(LinearInterpolate(figure[i], figure[i + 1], float(r) / RunLength));
+      }
+      else
+      {
+        const auto Start = float(PreviousRunLength - 1) / PreviousRunLength;
+        const auto t = Start + (1 - Start) * float(r + 1) / RunLength;
+        Result.push_back(LinearInterpolate(figure[i - 1], figure[i], t));
+      }
+    }
+
+    PreviousRunLength = RunLength;
+    k = RunEnd;
+  }
+
+  return Result;
+}
+
+} // namespace
+
+std::vector<std::pair<std::size_t, std::size_t>> GetDtwPath(
+    const FigureView   first,
+    const FigureView   second,
+    const DtwOptions & options
+  )
+{
+  if (first.Empty() || second.Empty())
+    return {};
+
+  return DtwSolver(first, second, options).Solve();
+}
+
+std::pair<std::vector<ImVec2>, std::vector<ImVec2>> AlignByDtw(
+    const FigureView   first,
+    const FigureView   second,
+    const DtwOptions & options
+  )
+{
+  const auto Path = GetDtwPath(first, second, options);
+
+  return { Resample(first, Path, true), Resample(second, Path, false) };
+}
+
+std::pair<std::vector<ImVec2>, std::vector<ImVec2>> MatchFigures(
+    const FigureView           first,
+    const FigureView           second,
+    const CorrespondenceMethod method
+  )
+{
+  if (first.Size() <= 2 || second.Size() <= 2)
+    return { ToVector(first), ToVector(second) };
+
+  if (method == CorrespondenceMethod::Dtw)
+    return AlignByDtw(first, second);
+
+  return FillMissingPoints(first, second);
+}
+
+void MatchFiguresInto(
+    const FigureView           first,
+    const FigureView           second,
+    const CorrespondenceMethod method,
+    FigureBuffer &             out_first,
+    FigureBuffer &             out_second
+  )
+{
+  if (first.Size() <= 2 || second.Size() <= 2)
+  {
+    out_first.Assign(first);
+    out_second.Assign(second);
+    return;
+  }
+
+  if (method == CorrespondenceMethod::Dtw)
+  {
+    // The warping itself dwarfs the copy
+    const auto [First, Second] = AlignByDtw(first, second);
+    out_first.Assign(First);
+    out_second.Assign(Second);
+    return;
+  }
+
+  FillMissingPointsInto(first, second, out_first, out_second);
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "FigureView.h"
+#include "FigureBuffer.h"
+
+#include <imgui.h>
+#include <vector>
+#include <utility>
+#include <cstddef>
+
+//
+// Point correspondence between two figures for morphing.
+//
+
+enum class CorrespondenceMethod
+{
+  Index, // Upsample the smaller figure and pair points by index
+  Dtw,   // Dynamic time warping on distance and tangent difference
+};
+
+struct DtwOptions
+{
+  // Half width of the Sakoe-Chiba band as a fraction of the longer figure
+  float BandRatio     = 0.1f;
+  // Cost of opposite tangents in pixels, 0 matches on distance only
+  float TangentWeight = 20.f;
+};
+
+// Aligns the figures with banded dynamic time warping and returns them
+// resampled along the optimal warping path, so point i of the first one
+// corresponds to point i of the second. Runs in O(n * w * log n) time and
+// O(n + m) memory: the path is recovered Hirschberg-style instead of from
+// a full cost matrix.
+std::pair<std::vector<ImVec2>, std::vector<ImVec2>> AlignByDtw(
+    const FigureView   first,
+    const FigureView   second,
+    const DtwOptions & options = {}
+  );
+
+// Warping path of AlignByDtw as (first index, second index) pairs
+std::vector<std::pair<std::size_t, std::size_t>> GetDtwPath(
+    const FigureView   first,
+    const FigureView   second,
+    const DtwOptions & options = {}
+  );
+
+// Matched copies of the figures with the same number of points. Figures of
+// fewer than three points are copied as they are.
+std::pair<std::vector<ImVec2>, std::vector<ImVec2>> MatchFigures(
+    const FigureView           first,
+    const FigureView           second,
+    const CorrespondenceMethod method
+  );
+
+// Same into structure-of-arrays buffers, reusing their storage
+void MatchFiguresInto(
+    const FigureView           first,
+    const FigureView           second,
+    const CorrespondenceMethod method,
+    FigureBuffer &             out_first,
+    FigureBuffer &             out_second
+  );
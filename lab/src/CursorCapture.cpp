@@ -0,0 +1,58 @@
+#include "CursorCapture.h"
+
+#define GLFW_INCLUDE_NONE
+#include <GLFW/glfw3.h>
+
+//
+// Interface
+//
+
+CursorCapture & CursorCapture::Instance()
+{
+  static CursorCapture Capture;
+  return Capture;
+}
+
+void CursorCapture::Attach(
+    GLFWwindow * window
+  )
+{
+  glfwSetCursorPosCallback(window, cursor_pos_callback);
+}
+
+void CursorCapture::BeginFrame()
+{
+  m_FrameSamples.clear();
+
+  Sample Current;
+
+  while (m_Ring.Pop(Current))
+    m_FrameSamples.push_back(Current);
+}
+
+const std::vector<CursorCapture::Sample> & CursorCapture::GetFrameSamples() const
+{
+  return m_FrameSamples;
+}
+
+//
+// Static service
+//
+
+void CursorCapture::cursor_pos_callback(
+    GLFWwindow * window,
+    double       x,
+    double       y
+  )
+{
+  // With multi-viewports ImGui works in absolute screen coordinates
+  if (ImGui::GetCurrentContext() && (ImGui::GetIO().ConfigFlags & ImGuiConfigFlags_ViewportsEnable))
+  {
+    int WindowX, WindowY;
+    glfwGetWindowPos(window, &WindowX, &WindowY);
+    x += WindowX;
+    y += WindowY;
+  }
+
+  Instance().m_Ring.Push(Sample{ ImVec2{ float(x), float(y) }, glfwGetTime() });
+}
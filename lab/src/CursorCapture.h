@@ -0,0 +1,58 @@
+#pragma once
+
+#include "RingBuffer.h"
+
+#include <imgui.h>
+#include <vector>
+
+struct GLFWwindow;
+
+//
+// Captures every cursor position GLFW reports, not only the one sampled
+// per frame. The cursor callback pushes samples into a lock-free ring,
+// the application drains it once per frame and windows read the samples
+// of the current frame in ImGui coordinates.
+//
+
+class CursorCapture
+{
+public: // Types
+
+  struct Sample
+  {
+    ImVec2 Position;
+    double Time = 0;
+  };
+
+public: // Interface
+
+  static CursorCapture & Instance();
+
+  // Must be called before the ImGui GLFW backend installs its callbacks,
+  // the backend then chains to ours
+  void Attach(
+      GLFWwindow * window
+    );
+
+  // Moves the samples captured since the previous frame to the frame list
+  void BeginFrame();
+
+  const std::vector<Sample> & GetFrameSamples() const;
+
+private: // Static service
+
+  static void cursor_pos_callback(
+      GLFWwindow * window,
+      double       x,
+      double       y
+    );
+
+private: // Constants
+
+  static constexpr std::size_t RING_CAPACITY = 4096;
+
+private: // Members
+
+  RingBuffer<Sample, RING_CAPACITY> m_Ring;
+  std::vector<Sample>               m_FrameSamples;
+};
@@ -1,6 +1,9 @@
 #include "DrawFigureWindow.h"
 
 #include "ImVecUtils.h"
+#include "CursorCapture.h"
+
+#include <exception>
 
 //
 // Construction
@@ -13,65 +16,216 @@ DrawFigureWindow::DrawFigureWindow(
     m_WindowName(window_name),
     m_Color(color)
 {
-  // Empty
+  const auto DefaultPath = window_name + ".fig";
+  DefaultPath.copy(m_FilePath.data(), m_FilePath.size() - 1);
 }
 
 //
 // Interface
 //
 
-const std::vector<ImVec2> DrawFigureWindow::GetPoints() const
+FigureView DrawFigureWindow::GetPoints() const
 {
+  if (m_File)
+    return m_File->GetPoints();
+
   return m_Points;
 }
 
+const FigureSnapshot & DrawFigureWindow::GetSnapshot() const
+{
+  return m_Snapshot;
+}
+
 //
 // IWindow
 //
 
-std::string DrawFigureWindow::GetWindowName() const
+std::string_view DrawFigureWindow::GetWindowName() const
 {
   return m_WindowName;
 }
 
 void DrawFigureWindow::UpdateFrameData()
 {
-  ImGui::Text("Points count: %d", m_Points.size());
+  ImGui::Text("Points count: %d, LOD levels: %d", (int)GetPoints().Size(), (int)m_Lod.GetLevelCount());
+  ImGui::Text("Drag to draw, Shift+drag to continue the figure");
+
+  ImGui::SliderFloat("Tolerance", &m_Tolerance, 0.5f, 20.f, "%.1f px");
 
-  ImGui::BeginChild("Viewport", ImVec2(-1, -1), true);
+  ShowFileControls();
 
-  const auto cursor_pos = ImGui::GetCursorScreenPos();
+  // Not in the middle of a stroke, the stroke is committed on release
+  if (const auto Command = m_History.ShowControls(); Command != FigureHistory::Command::None && !m_WasMouseDown)
+    ApplyHistory(Command);
+
+  m_Viewport.Begin();
 
-  const auto NewPoint = ImGui::GetMousePos() - cursor_pos;
   const bool IsMouseDown = ImGui::IsWindowHovered() && ImGui::IsMouseDown(ImGuiMouseButton_Left);
 
-  if (IsMouseDown)
-    m_Points.push_back(NewPoint);
+  if (IsMouseDown && !m_WasMouseDown)
+  {
+    // A stroke started with Shift continues the figure, the history then
+    // shares every chunk but the last one with the previous state
+    if (ImGui::GetIO().KeyShift)
+    {
+      if (m_File)
+        m_Points.Assign(m_File->GetPoints());
+    }
+    else
+    {
+      m_Points.Clear();
+      m_Bounds.Reset();
+    }
+
+    m_File.reset();
+    m_Simplifier.Reset(m_Tolerance / m_Viewport.GetZoom());
+    ++m_Version;
+  }
 
-  DrawFigure(m_Points, cursor_pos, m_Color, 3);
+  if (IsMouseDown || m_WasMouseDown)
+  {
+    // Samples captured between frames come first, the current position also
+    // covers platform windows the capture is not attached to
+    for (const auto & Sample : CursorCapture::Instance().GetFrameSamples())
+      AddStrokePoint(m_Viewport.ToCanvas(Sample.Position));
 
-  if (IsMouseDown)
-    m_Points.pop_back();
+    AddStrokePoint(m_Viewport.ToCanvas(ImGui::GetMousePos()));
+  }
 
   if (m_WasMouseDown && !IsMouseDown)
-    m_Points.push_back(NewPoint);
+  {
+    if (m_Simplifier.Finish(m_Points))
+      ++m_Version;
+
+    m_History.Commit(m_Points);
+  }
+
+  if (!IsMouseDown && m_LodVersion != m_Version)
+  {
+    m_Lod.Build(GetPoints());
+    m_LodVersion = m_Version;
+  }
 
-  if (IsMouseDown)
+  // A loaded figure is shared with its mapping, a drawn one with the
+  // chunks of the history state the stroke was committed to
+  if (!IsMouseDown && m_SnapshotVersion != m_Version)
   {
-    if (!m_WasMouseDown)
-      m_Points.clear();
+    m_Snapshot = m_File ? FigureSnapshot(m_File, m_File->GetPoints()) : m_History.GetSnapshot();
+    m_SnapshotVersion = m_Version;
+  }
+
+  const auto Pending = IsMouseDown ? m_Simplifier.GetPending() : std::nullopt;
 
-    if (m_Points.empty() || ImVecDistance(m_Points.back(), NewPoint) >= POINTS_INDENT)
+  if (Pending)
+    m_Points.PushBack(*Pending);
+
+  m_Bounds.Update(GetPoints());
+
+  const auto * Level = IsMouseDown ? nullptr : m_Lod.Select(m_Viewport.GetZoom());
+
+  // A finished figure lives in a GPU buffer, tessellated once per edit or
+  // LOD switch; the stroke in progress changes every frame
+  if (!IsMouseDown && (m_GpuVersion != m_Version || m_GpuLevel != Level))
+  {
+    const auto Points = Level ? FigureView(Level->Points) : GetPoints();
+    m_GpuFigure.Upload(Points.Size() >= 2 ? GetSpline(Points, SPLINE_POINTS_PER_SEGMENT) : std::vector<ImVec2>());
+    m_GpuVersion = m_Version;
+    m_GpuLevel = Level;
+  }
+
+  if (IsMouseDown || !m_GpuFigure.Draw(m_Viewport.GetOrigin(), m_Viewport.GetZoom(), m_Color, 3))
+  {
+    if (Level)
+      DrawFigure(Level->Points, Level->Bounds, m_Viewport.GetOrigin(), m_Color, 3, m_Viewport.GetZoom());
+    else
+      DrawFigure(GetPoints(), m_Bounds, m_Viewport.GetOrigin(), m_Color, 3, m_Viewport.GetZoom());
+  }
+
+  if (Pending)
+    m_Points.PopBack();
+
+  m_WasMouseDown = IsMouseDown;
+
+  m_Viewport.End();
+}
+
+//
+// Service
+//
+
+void DrawFigureWindow::AddStrokePoint(
+    const ImVec2 point
+  )
+{
+  if (m_Simplifier.Add(point, m_Points))
+    ++m_Version;
+}
+
+void DrawFigureWindow::ApplyHistory(
+    const FigureHistory::Command command
+  )
+{
+  const bool IsUndo = command == FigureHistory::Command::Undo;
+
+  if (IsUndo ? !m_History.CanUndo() : !m_History.CanRedo())
+    return;
+
+  // The history writes the changed chunks over the current points
+  if (m_File)
+  {
+    m_Points.Assign(m_File->GetPoints());
+    m_File.reset();
+  }
+
+  if (IsUndo)
+    m_History.Undo(m_Points);
+  else
+    m_History.Redo(m_Points);
+
+  m_Bounds.Reset();
+  ++m_Version;
+}
+
+void DrawFigureWindow::ShowFileControls()
+{
+  ImGui::InputText("##FilePath", m_FilePath.data(), m_FilePath.size());
+  ImGui::SameLine();
+
+  const std::string Path = m_FilePath.data();
+
+  try
+  {
+    if (ImGui::Button("Save"))
     {
-      m_Points.push_back(NewPoint);
+      // The file being replaced may be the one we have mapped
+      if (m_File && m_File->GetPath() == Path)
+      {
+        m_Points.Assign(m_File->GetPoints());
+        m_File.reset();
+      }
+
+      FigureFile::Save(Path, GetPoints());
+      m_FileError.clear();
     }
 
-    m_WasMouseDown = true;
+    ImGui::SameLine();
+
+    if (ImGui::Button("Load"))
+    {
+      m_File = std::make_shared<const FigureFile>(Path);
+      m_Points.Clear();
+      m_Bounds.Reset();
+      m_History.Commit(m_File->GetPoints());
+      ++m_Version;
+      m_FileError.clear();
+    }
   }
-  else
+  catch (const std::exception & ex)
   {
-    m_WasMouseDown = false;
+    m_FileError = ex.what();
   }
 
-  ImGui::EndChild();
+  if (!m_FileError.empty())
+    ImGui::TextColored(ImVec4{ 1, 0.3f, 0.3f, 1 }, "%s", m_FileError.c_str());
 }
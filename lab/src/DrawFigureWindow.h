@@ -1,9 +1,22 @@
 #pragma once
 
 #include "IWindow.h"
+#include "FigureView.h"
+#include "FigureBuffer.h"
+#include "FigureFile.h"
+#include "FigureHistory.h"
+#include "FigureSnapshot.h"
+#include "StrokeSimplifier.h"
+#include "SegmentBounds.h"
+#include "FigureLod.h"
+#include "CanvasViewport.h"
+#include "GpuFigureRenderer.h"
 
 #include <imgui.h>
 #include <vector>
+#include <memory>
+#include <array>
+#include <cstdint>
 
 class DrawFigureWindow :
   public IWindow
@@ -17,23 +30,54 @@ public: // Construction
 
 public: // Interface
 
-  const std::vector<ImVec2> GetPoints() const;
+  FigureView GetPoints() const;
+
+  // The figure as of the last finished edit, a stroke in progress is
+  // not part of it until it is committed
+  const FigureSnapshot & GetSnapshot() const;
 
 protected: // IWindow
 
-  std::string GetWindowName() const override;
+  std::string_view GetWindowName() const override;
 
   void UpdateFrameData() override;
 
+private: // Service
+
+  void ShowFileControls();
+
+  void AddStrokePoint(
+      const ImVec2 point
+    );
+
+  void ApplyHistory(
+      const FigureHistory::Command command
+    );
+
 private: // Constants
 
-  static constexpr float POINTS_INDENT = 25.f;
+  static constexpr float DEFAULT_TOLERANCE = 2.f;
 
 private: // Members
 
-  std::string         m_WindowName;
-  ImU32               m_Color;
-  std::vector<ImVec2> m_Points;
-  bool                m_WasMouseDown = false;
+  std::string                       m_WindowName;
+  ImU32                             m_Color;
+  FigureBuffer                      m_Points;
+  std::shared_ptr<const FigureFile> m_File;
+  SegmentBounds                     m_Bounds;
+  FigureLod                         m_Lod;
+  std::uint64_t                     m_LodVersion = 0;
+  FigureSnapshot                    m_Snapshot;
+  std::uint64_t                     m_SnapshotVersion = 0;
+  CanvasViewport                    m_Viewport;
+  std::array<char, 256>             m_FilePath{};
+  std::string                       m_FileError;
+  StrokeSimplifier                  m_Simplifier;
+  FigureHistory                     m_History;
+  float                             m_Tolerance = DEFAULT_TOLERANCE;
+  std::uint64_t                     m_Version = 0;
+  bool                              m_WasMouseDown = false;
+  GpuFigure                         m_GpuFigure;
+  std::uint64_t                     m_GpuVersion = 0;
+  const FigureLod::Level *          m_GpuLevel = nullptr;
 };
-
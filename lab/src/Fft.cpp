@@ -0,0 +1,73 @@
+#include "Fft.h"
+
+#include <stdexcept>
+#include <string>
+#include <numbers>
+#include <utility>
+
+std::size_t NextPowerOfTwo(
+    const std::size_t value
+  )
+{
+  std::size_t Result = 1;
+
+  while (Result < value)
+    Result <<= 1;
+
+  return Result;
+}
+
+void Fft(
+    std::vector<Complex> & data,
+    const bool             inverse
+  )
+{
+  const auto n = data.size();
+
+  if (n == 0 || (n & (n - 1)) != 0)
+    throw std::runtime_error("FFT: Size " + std::to_string(n) + " is not a power of two");
+
+  // Bit-reversal permutation
+  for (std::size_t i = 1, j = 0; i < n; ++i)
+  {
+    auto Bit = n >> 1;
+
+    for (; j & Bit; Bit >>= 1)
+      j ^= Bit;
+
+    j ^= Bit;
+
+    if (i < j)
+      std::swap(data[i], data[j]);
+  }
+
+  // Butterflies, twiddles of each stage computed once
+  std::vector<Complex> Twiddles(n / 2);
+
+  for (std::size_t Length = 2; Length <= n; Length <<= 1)
+  {
+    const auto Half = Length / 2;
+    const auto Angle = (inverse ? 2 : -2) * std::numbers::pi / Length;
+
+    for (std::size_t k = 0; k < Half; ++k)
+      Twiddles[k] = std::polar(1.0, Angle * k);
+
+    for (std::size_t i = 0; i < n; i += Length)
+    {
+      for (std::size_t k = 0; k < Half; ++k)
+      {
+        const auto u = data[i + k];
+        const auto v = data[i + k + Half] * Twiddles[k];
+
+        data[i + k] = u + v;
+        data[i + k + Half] = u - v;
+      }
+    }
+  }
+
+  if (inverse)
+  {
+    for (auto & Value : data)
+      Value /= double(n);
+  }
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <complex>
+#include <vector>
+#include <cstddef>
+
+//
+// Iterative radix-2 fast Fourier transform.
+//
+
+using Complex = std::complex<double>;
+
+// Smallest power of two not less than `value`
+std::size_t NextPowerOfTwo(
+    const std::size_t value
+  );
+
+// Transforms `data` in place, its size must be a power of two. The inverse
+// transform is scaled by 1 / N, so Fft(Fft(x), true) == x.
+void Fft(
+    std::vector<Complex> & data,
+    const bool             inverse = false
+  );
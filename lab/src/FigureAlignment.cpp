@@ -0,0 +1,209 @@
+#include "FigureAlignment.h"
+
+#include "ImVecUtils.h"
+#include "Fft.h"
+
+#include <cmath>
+
+namespace
+{
+
+// Largest gap between the ends of a closed figure, relative to its length
+constexpr float CLOSED_GAP_RATIO = 0.1f;
+
+// Resampling count limits, the count is the next power of two of the
+// larger figure. The cap matches FourierMorph, larger figures lose detail
+// finer than their length / MAX_SAMPLES.
+constexpr std::size_t MIN_SAMPLES = 64;
+constexpr std::size_t MAX_SAMPLES = 1 << 17;
+
+ImVec2 GetCenter(
+    const std::vector<ImVec2> & points
+  )
+{
+  double x = 0, y = 0;
+
+  for (const auto & Point : points)
+  {
+    x += Point.x;
+    y += Point.y;
+  }
+
+  return ImVec2{ float(x / points.size()), float(y / points.size()) };
+}
+
+std::vector<Complex> ToCentered(
+    const std::vector<ImVec2> & points,
+    const ImVec2                center
+  )
+{
+  std::vector<Complex> Result;
+  Result.reserve(points.size());
+
+  for (const auto & Point : points)
+    Result.emplace_back(Point.x - center.x, Point.y - center.y);
+
+  return Result;
+}
+
+} // namespace
+
+//
+// FigureAlignment
+//
+
+ImVec2 FigureAlignment::GetFactor(
+    const float t
+  ) const
+{
+  const auto Scale = std::pow(std::sqrt(Factor * Factor), t);
+  const auto Angle = std::atan2(Factor.y, Factor.x) * t;
+
+  return ImVec2{ Scale * std::cos(Angle), Scale * std::sin(Angle) };
+}
+
+//
+// Functions
+//
+
+bool IsClosed(
+    const FigureView points
+  )
+{
+  if (points.Size() < 3)
+    return false;
+
+  const auto Length = GetArcLengths(points).back();
+
+  return Length > 0 && ImVecDistance(points.Front(), points.Back()) <= CLOSED_GAP_RATIO * Length;
+}
+
+std::vector<ImVec2> ResampleClosed(
+    const FigureView  points,
+    const std::size_t count
+  )
+{
+  const auto n = points.Size();
+
+  std::vector<ImVec2> Result;
+  Result.reserve(count);
+
+  if (n == 0)
+    return Result;
+
+  const auto Perimeter = GetArcLengths(points).back() + ImVecDistance(points.Back(), points.Front());
+
+  if (Perimeter <= 0)
+  {
+    Result.assign(count, points.Front());
+    return Result;
+  }
+
+  const auto Step = double(Perimeter) / count;
+
+  // Walk the outline once, segment i goes from point i to point i + 1
+  // (the closing one from the last point back to the first)
+  std::size_t Segment = 0;
+  double SegmentStart = 0;
+  double SegmentLength = ImVecDistance(points[0], points[1 % n]);
+
+  for (std::size_t k = 0; k < count; ++k)
+  {
+    const auto Position = k * Step;
+
+    while (Position > SegmentStart + SegmentLength && Segment + 1 < n)
+    {
+      SegmentStart += SegmentLength;
+      ++Segment;
+      SegmentLength = ImVecDistance(points[Segment], points[(Segment + 1) % n]);
+    }
+
+    const auto t = SegmentLength > 0 ? float((Position - SegmentStart) / SegmentLength) : 0.f;
+    Result.push_back(LinearInterpolate(points[Segment], points[(Segment + 1) % n], std::min(t, 1.f)));
+  }
+
+  return Result;
+}
+
+std::optional<FigureAlignment> AlignClosedFigures(
+    const FigureView first,
+    const FigureView second,
+    const bool       with_rotation
+  )
+{
+  if (!IsClosed(first) || !IsClosed(second))
+    return std::nullopt;
+
+  // Figures of more than MAX_SAMPLES points are resampled down to it, the
+  // alignment and the morph then use the coarser outlines
+  const auto n = std::clamp(NextPowerOfTwo(std::max(first.Size(), second.Size())), MIN_SAMPLES, MAX_SAMPLES);
+
+  FigureAlignment Result;
+  Result.First = ResampleClosed(first, n);
+  Result.FirstCenter = GetCenter(Result.First);
+
+  auto Second = ResampleClosed(second, n);
+  Result.SecondCenter = GetCenter(Second);
+
+  const auto a = ToCentered(Result.First, Result.FirstCenter);
+  const auto b = ToCentered(Second, Result.SecondCenter);
+
+  // c(s) = sum a[k] * conj(b[k + s]) for every cyclic shift s at once:
+  // IFFT(A * conj(B))[t] = sum a[k] * conj(b[k - t]), so c(s) is at t = -s
+  auto A = a;
+  auto B = b;
+  Fft(A);
+  Fft(B);
+
+  for (std::size_t i = 0; i < n; ++i)
+    A[i] *= std::conj(B[i]);
+
+  Fft(A, true);
+
+  // Squared distance after the best rotation and scale falls as |c| grows,
+  // without rotation it falls as Re c grows
+  std::size_t Shift = 0;
+  double Best = -INFINITY;
+
+  for (std::size_t s = 0; s < n; ++s)
+  {
+    const auto c = A[(n - s) % n];
+    const auto Score = with_rotation ? std::abs(c) : c.real();
+
+    if (Score > Best)
+    {
+      Best = Score;
+      Shift = s;
+    }
+  }
+
+  Result.Second.reserve(n + 1);
+
+  for (std::size_t k = 0; k < n; ++k)
+    Result.Second.push_back(Second[(k + Shift) % n]);
+
+  // Procrustes: the rotation minimising sum |b'[k] - R * a[k]|^2 is the
+  // argument of the cross term, the scale is the ratio of the sizes
+  double NormA = 0, NormB = 0;
+  Complex Cross = 0;
+
+  for (std::size_t k = 0; k < n; ++k)
+  {
+    const auto bk = b[(k + Shift) % n];
+    Cross += bk * std::conj(a[k]);
+    NormA += std::norm(a[k]);
+    NormB += std::norm(bk);
+  }
+
+  if (NormA > 0 && NormB > 0)
+  {
+    const auto Angle = with_rotation ? std::arg(Cross) : 0.0;
+    const auto Factor = std::polar(std::sqrt(NormB / NormA), Angle);
+    Result.Factor = ImVec2{ float(Factor.real()), float(Factor.imag()) };
+  }
+
+  Result.First.push_back(Result.First.front());
+  Result.Second.push_back(Result.Second.front());
+
+  return Result;
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include "FigureView.h"
+
+#include <imgui.h>
+#include <vector>
+#include <optional>
+#include <cstddef>
+
+//
+// Start point and pose alignment of closed figures.
+//
+// Both figures are resampled to the same power-of-two count by arc length
+// (at most 2^17 points, larger figures are resampled down), the cyclic
+// shift of the second one that best matches the first is found by
+// circular cross-correlation with an FFT, and a Procrustes fit gives the
+// similarity transform between them. Morphing the shape in the first
+// figure's frame and interpolating the pose separately makes figures turn
+// and grow instead of collapsing through their centre.
+//
+
+struct FigureAlignment
+{
+  // Resampled figures, Second[i] matches First[i], both closed (the last
+  // point repeats the first one)
+  std::vector<ImVec2> First;
+  std::vector<ImVec2> Second;
+
+  ImVec2 FirstCenter  = ImVec2{ 0, 0 };
+  ImVec2 SecondCenter = ImVec2{ 0, 0 };
+
+  // Rotation and scale from the first figure's frame to the second one's,
+  // as a complex number
+  ImVec2 Factor = ImVec2{ 1, 0 };
+
+  // Rotation and scale at `t`: the angle and the log scale are interpolated
+  ImVec2 GetFactor(
+      const float t
+    ) const;
+};
+
+// True when the gap between the ends is small compared to the length
+bool IsClosed(
+    const FigureView points
+  );
+
+// `count` points spaced evenly by arc length along the closed outline,
+// starting at the first point
+std::vector<ImVec2> ResampleClosed(
+    const FigureView  points,
+    const std::size_t count
+  );
+
+// Nothing when either figure is not closed. Without rotation the shift
+// minimises the plain squared distance and the pose only scales.
+std::optional<FigureAlignment> AlignClosedFigures(
+    const FigureView first,
+    const FigureView second,
+    const bool       with_rotation
+  );
+
+//
+// Complex arithmetic on ImVec2
+//
+
+inline ImVec2 ComplexMultiply(ImVec2 lhs, ImVec2 rhs)
+{
+  return ImVec2{ lhs.x * rhs.x - lhs.y * rhs.y, lhs.x * rhs.y + lhs.y * rhs.x };
+}
+
+inline ImVec2 ComplexInverse(ImVec2 value)
+{
+  const auto Norm = value.x * value.x + value.y * value.y;
+
+  return ImVec2{ value.x / Norm, -value.y / Norm };
+}
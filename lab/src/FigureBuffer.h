@@ -0,0 +1,248 @@
+#pragma once
+
+#include "FigureView.h"
+
+#include <imgui.h>
+#include <memory>
+#include <new>
+#include <algorithm>
+#include <utility>
+#include <cstddef>
+#include <cstring>
+
+//
+// Owning structure-of-arrays figure storage: x and y coordinates live in
+// separate arrays aligned to a cache line, so kernels run over contiguous
+// floats and vectorize. The capacity is kept a multiple of SIMD_WIDTH
+// floats, loops may process the padded tail without a scalar remainder.
+//
+// Views are stride 1 FigureViews, ImVec2 points are only produced at the
+// draw boundary (ToVector).
+//
+
+class FigureBuffer
+{
+public: // Constants
+
+  static constexpr std::size_t ALIGNMENT  = 64;
+  static constexpr std::size_t SIMD_WIDTH = ALIGNMENT / sizeof(float);
+
+public: // Construction / Destruction
+
+  FigureBuffer() = default;
+
+  explicit FigureBuffer(
+      const FigureView points
+    )
+  {
+    Assign(points);
+  }
+
+  FigureBuffer(
+      const FigureBuffer & other
+    )
+  {
+    Assign(other);
+  }
+
+  FigureBuffer(
+      FigureBuffer && other
+    ) noexcept :
+      m_X(std::move(other.m_X)),
+      m_Y(std::move(other.m_Y)),
+      m_Size(std::exchange(other.m_Size, 0)),
+      m_Capacity(std::exchange(other.m_Capacity, 0))
+  {
+    // Empty
+  }
+
+  FigureBuffer & operator=(
+      const FigureBuffer & other
+    )
+  {
+    if (this != &other)
+      Assign(other);
+
+    return *this;
+  }
+
+  FigureBuffer & operator=(
+      FigureBuffer && other
+    ) noexcept
+  {
+    m_X = std::move(other.m_X);
+    m_Y = std::move(other.m_Y);
+    m_Size = std::exchange(other.m_Size, 0);
+    m_Capacity = std::exchange(other.m_Capacity, 0);
+    return *this;
+  }
+
+public: // Interface
+
+  std::size_t Size() const
+  {
+    return m_Size;
+  }
+
+  bool Empty() const
+  {
+    return m_Size == 0;
+  }
+
+  std::size_t Capacity() const
+  {
+    return m_Capacity;
+  }
+
+  float * X()
+  {
+    return m_X.get();
+  }
+
+  float * Y()
+  {
+    return m_Y.get();
+  }
+
+  const float * X() const
+  {
+    return m_X.get();
+  }
+
+  const float * Y() const
+  {
+    return m_Y.get();
+  }
+
+  ImVec2 operator[](const std::size_t i) const
+  {
+    return ImVec2{ m_X[i], m_Y[i] };
+  }
+
+  void Set(
+      const std::size_t i,
+      const ImVec2      point
+    )
+  {
+    m_X[i] = point.x;
+    m_Y[i] = point.y;
+  }
+
+  ImVec2 Back() const
+  {
+    return (*this)[m_Size - 1];
+  }
+
+  operator FigureView() const
+  {
+    return FigureView(m_X.get(), m_Y.get(), m_Size);
+  }
+
+  void Reserve(
+      const std::size_t capacity
+    )
+  {
+    if (capacity <= m_Capacity)
+      return;
+
+    const auto Capacity = (capacity + SIMD_WIDTH - 1) / SIMD_WIDTH * SIMD_WIDTH;
+    auto X = Allocate(Capacity);
+    auto Y = Allocate(Capacity);
+
+    if (m_Size)
+    {
+      std::memcpy(X.get(), m_X.get(), m_Size * sizeof(float));
+      std::memcpy(Y.get(), m_Y.get(), m_Size * sizeof(float));
+    }
+
+    m_X = std::move(X);
+    m_Y = std::move(Y);
+    m_Capacity = Capacity;
+  }
+
+  // New points are left uninitialized
+  void Resize(
+      const std::size_t size
+    )
+  {
+    if (size > m_Capacity)
+      Reserve(std::max(size, m_Capacity * 2));
+
+    m_Size = size;
+  }
+
+  void Clear()
+  {
+    m_Size = 0;
+  }
+
+  void PushBack(
+      const ImVec2 point
+    )
+  {
+    Resize(m_Size + 1);
+    Set(m_Size - 1, point);
+  }
+
+  void PopBack()
+  {
+    --m_Size;
+  }
+
+  void Insert(
+      const std::size_t i,
+      const ImVec2      point
+    )
+  {
+    Resize(m_Size + 1);
+    std::memmove(m_X.get() + i + 1, m_X.get() + i, (m_Size - 1 - i) * sizeof(float));
+    std::memmove(m_Y.get() + i + 1, m_Y.get() + i, (m_Size - 1 - i) * sizeof(float));
+    Set(i, point);
+  }
+
+  // Copies any view, interleaved or not
+  void Assign(
+      const FigureView points
+    )
+  {
+    Resize(points.Size());
+
+    if (points.Stride() == 1)
+    {
+      std::copy(points.X(), points.X() + points.Size(), m_X.get());
+      std::copy(points.Y(), points.Y() + points.Size(), m_Y.get());
+      return;
+    }
+
+    for (std::size_t i = 0; i < points.Size(); ++i)
+      Set(i, points[i]);
+  }
+
+private: // Types
+
+  struct AlignedDelete
+  {
+    void operator()(float * ptr) const
+    {
+      ::operator delete[](ptr, std::align_val_t(ALIGNMENT));
+    }
+  };
+
+  using Array = std::unique_ptr<float[], AlignedDelete>;
+
+private: // Service
+
+  static Array Allocate(
+      const std::size_t count
+    )
+  {
+    return Array(static_cast<float *>(::operator new[](count * sizeof(float), std::align_val_t(ALIGNMENT))));
+  }
+
+private: // Members
+
+  Array       m_X;
+  Array       m_Y;
+  std::size_t m_Size     = 0;
+  std::size_t m_Capacity = 0;
+};
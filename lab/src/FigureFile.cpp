@@ -0,0 +1,345 @@
+#include "FigureFile.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <cstring>
+
+namespace
+{
+
+constexpr char          FIGURE_MAGIC[8]    = { 'M', 'F', 'I', 'G', 'U', 'R', 'E', '\0' };
+constexpr std::uint32_t FIGURE_VERSION     = 1;
+constexpr std::uint32_t FLAG_ARC_LENGTHS   = 1u << 0;
+constexpr std::uint64_t SECTION_ALIGNMENT  = 64;
+
+struct FigureFileHeader
+{
+  char          Magic[8];
+  std::uint32_t Version;
+  std::uint32_t Flags;
+  std::uint64_t PointCount;
+  float         MinX;
+  float         MinY;
+  float         MaxX;
+  float         MaxY;
+  std::uint64_t XOffset;
+  std::uint64_t YOffset;
+  std::uint64_t ArcLengthOffset;
+};
+
+static_assert(sizeof(FigureFileHeader) == 64, "Figure file header must stay 64 bytes");
+
+std::uint64_t AlignUp(
+    const std::uint64_t value
+  )
+{
+  return (value + SECTION_ALIGNMENT - 1) & ~(SECTION_ALIGNMENT - 1);
+}
+
+const FigureFileHeader & GetHeader(
+    const std::uint8_t * data
+  )
+{
+  return *reinterpret_cast<const FigureFileHeader *>(data);
+}
+
+void WriteSection(
+    std::ofstream &     out,
+    const float *       data,
+    const std::uint64_t count,
+    const std::uint64_t offset
+  )
+{
+  static const char Padding[SECTION_ALIGNMENT] = {};
+
+  const auto Position = static_cast<std::uint64_t>(out.tellp());
+  out.write(Padding, offset - Position);
+  out.write(reinterpret_cast<const char *>(data), count * sizeof(float));
+}
+
+} // namespace
+
+//
+// Construction / Destruction
+//
+
+FigureFile::FigureFile(
+    const std::string & path
+  ) :
+    m_Path(path)
+{
+  Map();
+
+  try
+  {
+    Validate();
+  }
+  catch (...)
+  {
+    Unmap();
+    throw;
+  }
+}
+
+FigureFile::~FigureFile()
+{
+  Unmap();
+}
+
+//
+// Interface
+//
+
+FigureView FigureFile::GetPoints() const
+{
+  const auto & Header = GetHeader(m_Data);
+
+  return FigureView(
+      reinterpret_cast<const float *>(m_Data + Header.XOffset),
+      reinterpret_cast<const float *>(m_Data + Header.YOffset),
+      Header.PointCount
+    );
+}
+
+BoundingBox FigureFile::GetBounds() const
+{
+  const auto & Header = GetHeader(m_Data);
+
+  BoundingBox Result;
+  Result.Min = ImVec2{ Header.MinX, Header.MinY };
+  Result.Max = ImVec2{ Header.MaxX, Header.MaxY };
+  return Result;
+}
+
+bool FigureFile::HasArcLengths() const
+{
+  return GetHeader(m_Data).Flags & FLAG_ARC_LENGTHS;
+}
+
+const float * FigureFile::GetArcLengths() const
+{
+  if (!HasArcLengths())
+    return nullptr;
+
+  return reinterpret_cast<const float *>(m_Data + GetHeader(m_Data).ArcLengthOffset);
+}
+
+const std::string & FigureFile::GetPath() const
+{
+  return m_Path;
+}
+
+//
+// Static interface
+//
+
+void FigureFile::Save(
+    const std::string & path,
+    const FigureView    points,
+    const bool          with_arc_lengths
+  )
+{
+  const std::uint64_t Count = points.Size();
+  const std::uint64_t ArraySize = Count * sizeof(float);
+
+  std::vector<float> X, Y;
+  X.reserve(Count);
+  Y.reserve(Count);
+
+  for (std::size_t i = 0; i < Count; ++i)
+  {
+    X.push_back(points[i].x);
+    Y.push_back(points[i].y);
+  }
+
+  const auto Bounds = ::GetBounds(points);
+
+  FigureFileHeader Header = {};
+  std::memcpy(Header.Magic, FIGURE_MAGIC, sizeof(FIGURE_MAGIC));
+  Header.Version         = FIGURE_VERSION;
+  Header.Flags           = with_arc_lengths ? FLAG_ARC_LENGTHS : 0;
+  Header.PointCount      = Count;
+  Header.MinX            = Bounds.IsEmpty() ? 0 : Bounds.Min.x;
+  Header.MinY            = Bounds.IsEmpty() ? 0 : Bounds.Min.y;
+  Header.MaxX            = Bounds.IsEmpty() ? 0 : Bounds.Max.x;
+  Header.MaxY            = Bounds.IsEmpty() ? 0 : Bounds.Max.y;
+  Header.XOffset         = AlignUp(sizeof(FigureFileHeader));
+  Header.YOffset         = AlignUp(Header.XOffset + ArraySize);
+  Header.ArcLengthOffset = with_arc_lengths ? AlignUp(Header.YOffset + ArraySize) : 0;
+
+  // Write next to the target and rename over it, so processes that still
+  // have the old file mapped keep a valid view
+  const auto TempPath = path + ".tmp";
+
+  {
+    std::ofstream Out(TempPath, std::ios::binary | std::ios::trunc);
+
+    if (!Out)
+      throw std::runtime_error("Figure file: Failed to open " + TempPath + " for writing");
+
+    Out.write(reinterpret_cast<const char *>(&Header), sizeof(Header));
+    WriteSection(Out, X.data(), Count, Header.XOffset);
+    WriteSection(Out, Y.data(), Count, Header.YOffset);
+
+    if (with_arc_lengths)
+    {
+      const auto ArcLengths = ::GetArcLengths(points);
+      WriteSection(Out, ArcLengths.data(), Count, Header.ArcLengthOffset);
+    }
+
+    if (!Out)
+      throw std::runtime_error("Figure file: Failed to write " + TempPath);
+  }
+
+  std::error_code Error;
+  std::filesystem::rename(TempPath, path, Error);
+
+  if (Error)
+    throw std::runtime_error("Figure file: Failed to replace " + path + ": " + Error.message());
+}
+
+//
+// Service
+//
+
+#ifdef _WIN32
+
+void FigureFile::Map()
+{
+  m_FileHandle = CreateFileA(m_Path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+
+  if (m_FileHandle == INVALID_HANDLE_VALUE)
+  {
+    m_FileHandle = nullptr;
+    throw std::runtime_error("Figure file: Failed to open " + m_Path);
+  }
+
+  LARGE_INTEGER Size;
+
+  if (!GetFileSizeEx(m_FileHandle, &Size) || Size.QuadPart == 0)
+  {
+    Unmap();
+    throw std::runtime_error("Figure file: Failed to get size of " + m_Path);
+  }
+
+  m_Size = static_cast<std::uint64_t>(Size.QuadPart);
+  m_MappingHandle = CreateFileMappingA(m_FileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+  if (!m_MappingHandle)
+  {
+    Unmap();
+    throw std::runtime_error("Figure file: Failed to map " + m_Path);
+  }
+
+  m_Data = static_cast<const std::uint8_t *>(MapViewOfFile(m_MappingHandle, FILE_MAP_READ, 0, 0, 0));
+
+  if (!m_Data)
+  {
+    Unmap();
+    throw std::runtime_error("Figure file: Failed to map " + m_Path);
+  }
+}
+
+void FigureFile::Unmap()
+{
+  if (m_Data)
+    UnmapViewOfFile(m_Data);
+
+  if (m_MappingHandle)
+    CloseHandle(m_MappingHandle);
+
+  if (m_FileHandle)
+    CloseHandle(m_FileHandle);
+
+  m_Data = nullptr;
+  m_MappingHandle = nullptr;
+  m_FileHandle = nullptr;
+  m_Size = 0;
+}
+
+#else
+
+void FigureFile::Map()
+{
+  const int Fd = open(m_Path.c_str(), O_RDONLY);
+
+  if (Fd < 0)
+    throw std::runtime_error("Figure file: Failed to open " + m_Path);
+
+  struct stat Stat;
+
+  if (fstat(Fd, &Stat) != 0 || Stat.st_size == 0)
+  {
+    close(Fd);
+    throw std::runtime_error("Figure file: Failed to get size of " + m_Path);
+  }
+
+  m_Size = static_cast<std::uint64_t>(Stat.st_size);
+
+  void * Data = mmap(nullptr, m_Size, PROT_READ, MAP_SHARED, Fd, 0);
+  close(Fd);
+
+  if (Data == MAP_FAILED)
+  {
+    m_Size = 0;
+    throw std::runtime_error("Figure file: Failed to map " + m_Path);
+  }
+
+  m_Data = static_cast<const std::uint8_t *>(Data);
+}
+
+void FigureFile::Unmap()
+{
+  if (m_Data)
+    munmap(const_cast<std::uint8_t *>(m_Data), m_Size);
+
+  m_Data = nullptr;
+  m_Size = 0;
+}
+
+#endif // _WIN32
+
+void FigureFile::Validate() const
+{
+  if (m_Size < sizeof(FigureFileHeader))
+    throw std::runtime_error("Figure file: " + m_Path + " is too small");
+
+  const auto & Header = GetHeader(m_Data);
+
+  if (std::memcmp(Header.Magic, FIGURE_MAGIC, sizeof(FIGURE_MAGIC)) != 0)
+    throw std::runtime_error("Figure file: " + m_Path + " is not a figure file");
+
+  if (Header.Version != FIGURE_VERSION)
+    throw std::runtime_error("Figure file: " + m_Path + " has unsupported version " + std::to_string(Header.Version));
+
+  if (Header.PointCount > m_Size / sizeof(float))
+    throw std::runtime_error("Figure file: " + m_Path + " is truncated");
+
+  const auto ArraySize = Header.PointCount * sizeof(float);
+
+  const auto IsValidSection = [&](const std::uint64_t offset)
+  {
+    return offset % SECTION_ALIGNMENT == 0
+        && offset >= sizeof(FigureFileHeader)
+        && offset <= m_Size
+        && ArraySize <= m_Size - offset;
+  };
+
+  if (!IsValidSection(Header.XOffset) || !IsValidSection(Header.YOffset))
+    throw std::runtime_error("Figure file: " + m_Path + " is truncated");
+
+  if ((Header.Flags & FLAG_ARC_LENGTHS) && !IsValidSection(Header.ArcLengthOffset))
+    throw std::runtime_error("Figure file: " + m_Path + " is truncated");
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "FigureView.h"
+#include "ImVecUtils.h"
+
+#include <string>
+#include <cstdint>
+
+//
+// Binary figure file opened through a read-only memory mapping.
+//
+// Layout: fixed header (point count, bounding box, section offsets),
+// then 64-byte aligned float32 x and y arrays and an optional float32
+// arc-length table. The mapped arrays are handed out as a FigureView,
+// so opening a file neither copies nor parses the points.
+//
+
+class FigureFile
+{
+public: // Construction / Destruction
+
+  explicit FigureFile(
+      const std::string & path
+    );
+
+  ~FigureFile();
+
+  FigureFile(const FigureFile &) = delete;
+  FigureFile & operator=(const FigureFile &) = delete;
+
+public: // Interface
+
+  FigureView GetPoints() const;
+
+  BoundingBox GetBounds() const;
+
+  bool HasArcLengths() const;
+
+  const float * GetArcLengths() const;
+
+  const std::string & GetPath() const;
+
+public: // Static interface
+
+  static void Save(
+      const std::string & path,
+      const FigureView    points,
+      const bool          with_arc_lengths = true
+    );
+
+private: // Service
+
+  void Map();
+  void Unmap();
+  void Validate() const;
+
+private: // Members
+
+  std::string         m_Path;
+  const std::uint8_t * m_Data = nullptr;
+  std::uint64_t        m_Size = 0;
+#ifdef _WIN32
+  void *               m_FileHandle    = nullptr;
+  void *               m_MappingHandle = nullptr;
+#endif
+};
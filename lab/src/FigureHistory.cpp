@@ -0,0 +1,287 @@
+#include "FigureHistory.h"
+
+#include <imgui.h>
+
+#include <algorithm>
+
+//
+// Construction
+//
+
+FigureHistory::FigureHistory(
+    const std::size_t budget
+  ) :
+    m_States(1),
+    m_Budget(budget)
+{
+  // Empty
+}
+
+//
+// Interface
+//
+
+void FigureHistory::Commit(
+    const FigureView points
+  )
+{
+  const auto & Current = m_States[m_Current];
+
+  State New;
+  New.Size = points.Size();
+  New.Chunks.reserve((points.Size() + CHUNK_POINTS - 1) / CHUNK_POINTS);
+
+  bool IsChanged = New.Size != Current.Size;
+  std::size_t NewBytes = 0;
+
+  for (std::size_t First = 0; First < points.Size(); First += CHUNK_POINTS)
+  {
+    const auto i = First / CHUNK_POINTS;
+
+    if (i < Current.Chunks.size() && IsEqual(*Current.Chunks[i], points, First))
+    {
+      New.Chunks.push_back(Current.Chunks[i]);
+      continue;
+    }
+
+    auto Changed = std::make_shared<Chunk>();
+    Changed->Count = std::min(CHUNK_POINTS, points.Size() - First);
+
+    for (std::size_t k = 0; k < Changed->Count; ++k)
+    {
+      const auto Point = points[First + k];
+      Changed->X[k] = Point.x;
+      Changed->Y[k] = Point.y;
+    }
+
+    New.Chunks.push_back(std::move(Changed));
+    NewBytes += sizeof(Chunk);
+    IsChanged = true;
+  }
+
+  if (!IsChanged)
+    return;
+
+  while (m_States.size() > m_Current + 1)
+  {
+    Drop(m_States.back());
+    m_States.pop_back();
+  }
+
+  m_Bytes += NewBytes + New.Chunks.capacity() * sizeof(ChunkPtr);
+  m_States.push_back(std::move(New));
+  m_Current = m_States.size() - 1;
+
+  Trim();
+}
+
+void FigureHistory::Reset(
+    const FigureView points
+  )
+{
+  m_States.assign(1, State());
+  m_Current = 0;
+  m_Bytes = 0;
+
+  Commit(points);
+
+  // The empty state, unless the points are empty too or Commit() trimmed it
+  if (m_States.size() > 1)
+    m_States.pop_front();
+
+  m_Current = 0;
+}
+
+bool FigureHistory::CanUndo() const
+{
+  return m_Current > 0;
+}
+
+bool FigureHistory::CanRedo() const
+{
+  return m_Current + 1 < m_States.size();
+}
+
+bool FigureHistory::Undo(
+    FigureBuffer &        points,
+    const WriteCallback & on_write
+  )
+{
+  if (!CanUndo())
+    return false;
+
+  MoveTo(m_Current - 1, points, on_write);
+  return true;
+}
+
+bool FigureHistory::Redo(
+    FigureBuffer &        points,
+    const WriteCallback & on_write
+  )
+{
+  if (!CanRedo())
+    return false;
+
+  MoveTo(m_Current + 1, points, on_write);
+  return true;
+}
+
+void FigureHistory::SetBudget(
+    const std::size_t budget
+  )
+{
+  m_Budget = budget;
+  Trim();
+}
+
+std::size_t FigureHistory::GetBudget() const
+{
+  return m_Budget;
+}
+
+std::size_t FigureHistory::GetBytes() const
+{
+  return m_Bytes;
+}
+
+std::size_t FigureHistory::GetStateCount() const
+{
+  return m_States.size();
+}
+
+FigureSnapshot FigureHistory::GetSnapshot() const
+{
+  auto Chunks = std::make_shared<const std::vector<ChunkPtr>>(m_States[m_Current].Chunks);
+
+  std::vector<FigureView> Runs;
+  Runs.reserve(Chunks->size());
+
+  for (const auto & Chunk : *Chunks)
+    Runs.emplace_back(Chunk->X.data(), Chunk->Y.data(), Chunk->Count);
+
+  return FigureSnapshot(std::move(Chunks), std::move(Runs));
+}
+
+FigureHistory::Command FigureHistory::ShowControls()
+{
+  auto Result = Command::None;
+
+  ImGui::BeginDisabled(!CanUndo());
+
+  if (ImGui::Button("Undo"))
+    Result = Command::Undo;
+
+  ImGui::EndDisabled();
+  ImGui::SameLine();
+  ImGui::BeginDisabled(!CanRedo());
+
+  if (ImGui::Button("Redo"))
+    Result = Command::Redo;
+
+  ImGui::EndDisabled();
+  ImGui::SameLine();
+
+  ImGui::Text(
+      "History: %d of %d, %.2f MiB",
+      int(m_Current + 1), int(m_States.size()), double(m_Bytes) / (1 << 20)
+    );
+
+  int BudgetMiB = int(m_Budget >> 20);
+
+  if (ImGui::SliderInt("History budget", &BudgetMiB, 1, 1024, "%d MiB", ImGuiSliderFlags_Logarithmic))
+    SetBudget(std::size_t(std::max(BudgetMiB, 1)) << 20);
+
+  const auto & IO = ImGui::GetIO();
+
+  // Ctrl+Z in a text field (e.g. the file path) belongs to the field
+  if (IO.KeyCtrl && !IO.WantTextInput && ImGui::IsWindowFocused(ImGuiFocusedFlags_RootAndChildWindows))
+  {
+    if (ImGui::IsKeyPressed(ImGuiKey_Z))
+      Result = IO.KeyShift ? Command::Redo : Command::Undo;
+
+    if (ImGui::IsKeyPressed(ImGuiKey_Y))
+      Result = Command::Redo;
+  }
+
+  return Result;
+}
+
+//
+// Service
+//
+
+void FigureHistory::MoveTo(
+    const std::size_t     index,
+    FigureBuffer &        points,
+    const WriteCallback & on_write
+  )
+{
+  const auto & From = m_States[m_Current];
+  const auto & To = m_States[index];
+
+  points.Resize(To.Size);
+
+  for (std::size_t i = 0; i < To.Chunks.size(); ++i)
+  {
+    if (i < From.Chunks.size() && From.Chunks[i] == To.Chunks[i])
+      continue;
+
+    const auto & Source = *To.Chunks[i];
+
+    if (on_write)
+      on_write(i * CHUNK_POINTS, FigureView(Source.X.data(), Source.Y.data(), Source.Count));
+
+    std::copy_n(Source.X.begin(), Source.Count, points.X() + i * CHUNK_POINTS);
+    std::copy_n(Source.Y.begin(), Source.Count, points.Y() + i * CHUNK_POINTS);
+  }
+
+  m_Current = index;
+}
+
+void FigureHistory::Drop(
+    State & state
+  )
+{
+  for (const auto & Shared : state.Chunks)
+    if (Shared.use_count() == 1)
+      m_Bytes -= sizeof(Chunk);
+
+  m_Bytes -= state.Chunks.capacity() * sizeof(ChunkPtr);
+  state.Chunks.clear();
+}
+
+void FigureHistory::Trim()
+{
+  while (m_Bytes > m_Budget && m_Current > 0)
+  {
+    Drop(m_States.front());
+    m_States.pop_front();
+    --m_Current;
+  }
+
+  while (m_Bytes > m_Budget && CanRedo())
+  {
+    Drop(m_States.back());
+    m_States.pop_back();
+  }
+}
+
+bool FigureHistory::IsEqual(
+    const Chunk &     chunk,
+    const FigureView  points,
+    const std::size_t first
+  )
+{
+  if (chunk.Count != std::min(CHUNK_POINTS, points.Size() - first))
+    return false;
+
+  for (std::size_t k = 0; k < chunk.Count; ++k)
+  {
+    const auto Point = points[first + k];
+
+    if (chunk.X[k] != Point.x || chunk.Y[k] != Point.y)
+      return false;
+  }
+
+  return true;
+}
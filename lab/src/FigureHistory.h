@@ -0,0 +1,149 @@
+#pragma once
+
+#include "FigureView.h"
+#include "FigureBuffer.h"
+#include "FigureSnapshot.h"
+
+#include <deque>
+#include <vector>
+#include <array>
+#include <memory>
+#include <functional>
+#include <cstddef>
+
+//
+// Undo / redo history of a figure. A state is a list of fixed-size chunks
+// of points, and a committed state shares every chunk that did not change
+// with the current one, so an edit costs only the chunks it touched.
+//
+// Undo and redo write to the figure only the chunks that differ between
+// the two states and report them, so caches of the figure can follow the
+// points that changed. The history is kept under a byte budget by dropping the
+// oldest states, then the redo states; the current state is never dropped.
+//
+
+class FigureHistory
+{
+public: // Types
+
+  enum class Command
+  {
+    None,
+    Undo,
+    Redo,
+  };
+
+  // Called for every chunk an undo or redo rewrites, before it is written:
+  // the figure (already resized) still holds the old points from `first`
+  // on, `points` are the new ones
+  using WriteCallback = std::function<void(std::size_t first, FigureView points)>;
+
+public: // Constants
+
+  static constexpr std::size_t CHUNK_POINTS   = 256;
+  static constexpr std::size_t DEFAULT_BUDGET = 16 << 20;
+
+public: // Construction
+
+  // The history starts with an empty figure as its only state
+  explicit FigureHistory(
+      const std::size_t budget = DEFAULT_BUDGET
+    );
+
+  FigureHistory(const FigureHistory &) = delete;
+  FigureHistory & operator=(const FigureHistory &) = delete;
+
+public: // Interface
+
+  // Makes `points` the current state, the redo states are dropped. Nothing
+  // is recorded when the points equal the current state.
+  void Commit(
+      const FigureView points
+    );
+
+  // Drops every state, `points` becomes the only one
+  void Reset(
+      const FigureView points
+    );
+
+  bool CanUndo() const;
+
+  bool CanRedo() const;
+
+  // `points` must hold the current state
+  bool Undo(
+      FigureBuffer &        points,
+      const WriteCallback & on_write = {}
+    );
+
+  bool Redo(
+      FigureBuffer &        points,
+      const WriteCallback & on_write = {}
+    );
+
+  void SetBudget(
+      const std::size_t budget
+    );
+
+  std::size_t GetBudget() const;
+
+  // Chunks and chunk lists of all the states, shared chunks counted once.
+  // The shared_ptr control block allocated with each chunk (a few words
+  // against sizeof(Chunk) of 2 KiB) and the deque nodes are not counted.
+  std::size_t GetBytes() const;
+
+  std::size_t GetStateCount() const;
+
+  // The current state, sharing its chunks rather than copying the points
+  FigureSnapshot GetSnapshot() const;
+
+  // Undo / Redo buttons, the history size and budget, and Ctrl+Z, Ctrl+Y,
+  // Ctrl+Shift+Z while the current ImGui window is focused
+  Command ShowControls();
+
+private: // Types
+
+  struct Chunk
+  {
+    std::size_t                     Count = 0;
+    std::array<float, CHUNK_POINTS> X;
+    std::array<float, CHUNK_POINTS> Y;
+  };
+
+  using ChunkPtr = std::shared_ptr<const Chunk>;
+
+  struct State
+  {
+    std::vector<ChunkPtr> Chunks;
+    std::size_t           Size = 0;
+  };
+
+private: // Service
+
+  // Writes the chunks of state `index` that the current state does not share
+  void MoveTo(
+      const std::size_t     index,
+      FigureBuffer &        points,
+      const WriteCallback & on_write
+    );
+
+  // Releases the bytes of the chunks no other state holds
+  void Drop(
+      State & state
+    );
+
+  void Trim();
+
+  static bool IsEqual(
+      const Chunk &     chunk,
+      const FigureView  points,
+      const std::size_t first
+    );
+
+private: // Members
+
+  std::deque<State> m_States;
+  std::size_t       m_Current = 0;
+  std::size_t       m_Budget  = DEFAULT_BUDGET;
+  std::size_t       m_Bytes   = 0;
+};
@@ -0,0 +1,155 @@
+#include "FigureLod.h"
+
+#include "ImVecUtils.h"
+
+#include <algorithm>
+
+//
+// Interface
+//
+
+void FigureLod::Reset()
+{
+  m_Levels.clear();
+}
+
+void FigureLod::Build(
+    const FigureView points
+  )
+{
+  m_Levels.clear();
+
+  if (points.Size() < MIN_POINTS)
+    return;
+
+  const auto Bounds = GetBounds(points);
+  const auto Extent = std::max(Bounds.Max.x - Bounds.Min.x, Bounds.Max.y - Bounds.Min.y);
+
+  auto Previous = points;
+  float Error = 0;
+
+  for (float Tolerance = BASE_TOLERANCE; Tolerance < Extent; Tolerance *= 2)
+  {
+    auto Simplified = SimplifyPolyline(Previous, Tolerance);
+
+    if (Simplified.size() > Previous.Size() * MIN_REDUCTION)
+      continue;
+
+    // Each level simplifies the previous one, so the errors add up
+    Level Current;
+    Current.Points = std::move(Simplified);
+    Current.Error = Error + Tolerance;
+    Current.Bounds.Update(Current.Points);
+
+    m_Levels.push_back(std::move(Current));
+
+    Previous = m_Levels.back().Points;
+    Error = m_Levels.back().Error;
+
+    if (Previous.Size() < MIN_LEVEL_POINTS)
+      break;
+  }
+}
+
+const FigureLod::Level * FigureLod::Select(
+    const float zoom
+  ) const
+{
+  for (auto Level = m_Levels.rbegin(); Level != m_Levels.rend(); ++Level)
+    if (Level->Error * zoom < 1)
+      return &*Level;
+
+  return nullptr;
+}
+
+std::size_t FigureLod::GetLevelCount() const
+{
+  return m_Levels.size();
+}
+
+//
+// FigurePairLod
+//
+
+void FigurePairLod::Reset()
+{
+  m_Levels.clear();
+}
+
+void FigurePairLod::Build(
+    const FigureView first,
+    const FigureView second
+  )
+{
+  m_Levels.clear();
+
+  if (first.Size() != second.Size() || first.Size() < FigureLod::MIN_POINTS)
+    return;
+
+  const auto FirstBounds = GetBounds(first);
+  const auto SecondBounds = GetBounds(second);
+  const auto Extent = std::max({
+      FirstBounds.Max.x - FirstBounds.Min.x, FirstBounds.Max.y - FirstBounds.Min.y,
+      SecondBounds.Max.x - SecondBounds.Min.x, SecondBounds.Max.y - SecondBounds.Min.y
+    });
+
+  auto PreviousFirst = first;
+  auto PreviousSecond = second;
+  float Error = 0;
+
+  for (float Tolerance = FigureLod::BASE_TOLERANCE; Tolerance < Extent; Tolerance *= 2)
+  {
+    // A point is dropped only if both figures can do without it
+    const auto Indices = SimplifyIndices(PreviousFirst.Size(), Tolerance, [&](std::size_t i, std::size_t a, std::size_t b)
+    {
+      return std::max(
+          SegmentDistance(PreviousFirst[i], PreviousFirst[a], PreviousFirst[b]),
+          SegmentDistance(PreviousSecond[i], PreviousSecond[a], PreviousSecond[b])
+        );
+    });
+
+    if (Indices.size() > PreviousFirst.Size() * FigureLod::MIN_REDUCTION)
+      continue;
+
+    Level Current;
+    Current.Error = Error + Tolerance;
+    Current.First.reserve(Indices.size());
+    Current.Second.reserve(Indices.size());
+
+    for (const auto i : Indices)
+    {
+      Current.First.push_back(PreviousFirst[i]);
+      Current.Second.push_back(PreviousSecond[i]);
+    }
+
+    m_Levels.push_back(std::move(Current));
+
+    PreviousFirst = m_Levels.back().First;
+    PreviousSecond = m_Levels.back().Second;
+    Error = m_Levels.back().Error;
+
+    if (PreviousFirst.Size() < FigureLod::MIN_LEVEL_POINTS)
+      break;
+  }
+}
+
+const FigurePairLod::Level * FigurePairLod::Select(
+    const float zoom
+  ) const
+{
+  for (auto Level = m_Levels.rbegin(); Level != m_Levels.rend(); ++Level)
+    if (Level->Error * zoom < 1)
+      return &*Level;
+
+  return nullptr;
+}
+
+std::size_t FigurePairLod::GetLevelCount() const
+{
+  return m_Levels.size();
+}
+
+const std::vector<FigurePairLod::Level> & FigurePairLod::GetLevels() const
+{
+  return m_Levels;
+}
@@ -0,0 +1,94 @@
+#pragma once
+
+#include "FigureView.h"
+#include "SegmentBounds.h"
+
+#include <imgui.h>
+#include <vector>
+
+//
+// Level-of-detail pyramid of a figure. Every level is a simplification of
+// the previous one and carries a bound of its deviation from the original
+// figure in canvas units, so drawing can pick the coarsest level whose
+// error stays below one screen pixel at the current zoom.
+//
+
+class FigureLod
+{
+public: // Types
+
+  struct Level
+  {
+    std::vector<ImVec2> Points;
+    SegmentBounds       Bounds;
+    float               Error = 0;
+  };
+
+public: // Interface
+
+  void Reset();
+
+  void Build(
+      const FigureView points
+    );
+
+  // Coarsest level that is exact to a pixel at `zoom`, nullptr when only the
+  // full resolution figure is
+  const Level * Select(
+      const float zoom
+    ) const;
+
+  std::size_t GetLevelCount() const;
+
+public: // Constants
+
+  // Smaller figures are cheap enough to always draw at full resolution
+  static constexpr std::size_t MIN_POINTS       = 1024;
+  static constexpr std::size_t MIN_LEVEL_POINTS = 16;
+  static constexpr float       BASE_TOLERANCE   = 0.25f;
+  // A level has to drop at least a quarter of the points to be worth keeping
+  static constexpr float       MIN_REDUCTION    = 0.75f;
+
+private: // Members
+
+  std::vector<Level> m_Levels;
+};
+
+//
+// Level-of-detail pyramid of two figures with matched points. Both figures
+// keep the same point indices on every level, so a level can be morphed
+// directly. The level error bounds the deviation of either figure.
+//
+
+class FigurePairLod
+{
+public: // Types
+
+  struct Level
+  {
+    std::vector<ImVec2> First;
+    std::vector<ImVec2> Second;
+    float               Error = 0;
+  };
+
+public: // Interface
+
+  void Reset();
+
+  void Build(
+      const FigureView first,
+      const FigureView second
+    );
+
+  const Level * Select(
+      const float zoom
+    ) const;
+
+  std::size_t GetLevelCount() const;
+
+  const std::vector<Level> & GetLevels() const;
+
+private: // Members
+
+  std::vector<Level> m_Levels;
+};
@@ -0,0 +1,77 @@
+#include "FigureSnapshot.h"
+
+#include <utility>
+
+//
+// Construction
+//
+
+FigureSnapshot::FigureSnapshot(
+    std::shared_ptr<const void> owner,
+    const FigureView            points
+  ) :
+    FigureSnapshot(std::move(owner), std::vector<FigureView>{ points })
+{
+  // Empty
+}
+
+FigureSnapshot::FigureSnapshot(
+    std::shared_ptr<const void> owner,
+    std::vector<FigureView>     runs
+  ) :
+    m_Data(std::make_shared<Data>())
+{
+  m_Data->Owner = std::move(owner);
+  m_Data->Runs = std::move(runs);
+
+  for (const auto & Run : m_Data->Runs)
+    m_Data->Size += Run.Size();
+}
+
+//
+// Interface
+//
+
+std::size_t FigureSnapshot::Size() const
+{
+  return m_Data ? m_Data->Size : 0;
+}
+
+bool FigureSnapshot::Empty() const
+{
+  return Size() == 0;
+}
+
+FigureView FigureSnapshot::GetPoints() const
+{
+  if (!m_Data || m_Data->Runs.empty())
+    return FigureView();
+
+  if (m_Data->Runs.size() == 1)
+    return m_Data->Runs.front();
+
+  std::call_once(m_Data->Gathered, [this]
+    {
+      auto & Points = m_Data->Points;
+      Points.Resize(m_Data->Size);
+
+      std::size_t First = 0;
+
+      for (const auto & Run : m_Data->Runs)
+      {
+        for (std::size_t i = 0; i < Run.Size(); ++i)
+          Points.Set(First + i, Run[i]);
+
+        First += Run.Size();
+      }
+    });
+
+  return m_Data->Points;
+}
+
+bool FigureSnapshot::operator==(
+    const FigureSnapshot & other
+  ) const
+{
+  return m_Data == other.m_Data;
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include "FigureView.h"
+#include "FigureBuffer.h"
+
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <cstddef>
+
+//
+// Immutable points of a figure handed from the UI thread to the workers.
+// The snapshot shares the owner of the points instead of copying them: a
+// loaded figure is viewed in its file mapping, a drawn one in the chunks
+// of its history state. Points split in several runs are gathered into
+// one array the first time they are read, normally on a worker.
+//
+
+class FigureSnapshot
+{
+public: // Construction
+
+  FigureSnapshot() = default;
+
+  // `points` stay valid as long as `owner` is alive
+  FigureSnapshot(
+      std::shared_ptr<const void> owner,
+      const FigureView            points
+    );
+
+  // The figure is the concatenation of `runs`
+  FigureSnapshot(
+      std::shared_ptr<const void> owner,
+      std::vector<FigureView>     runs
+    );
+
+public: // Interface
+
+  std::size_t Size() const;
+
+  bool Empty() const;
+
+  // Valid as long as a copy of the snapshot is alive, safe to call from
+  // several threads at once
+  FigureView GetPoints() const;
+
+  // Snapshots are equal when they were taken of the same points
+  bool operator==(const FigureSnapshot & other) const;
+
+private: // Types
+
+  struct Data
+  {
+    std::shared_ptr<const void> Owner;
+    std::vector<FigureView>     Runs;
+    std::size_t                 Size = 0;
+    std::once_flag              Gathered;
+    FigureBuffer                Points; // Runs gathered, when there are several
+  };
+
+private: // Members
+
+  std::shared_ptr<Data> m_Data;
+};
@@ -0,0 +1,123 @@
+#pragma once
+
+#include <imgui.h>
+#include <vector>
+#include <memory_resource>
+#include <cstddef>
+
+//
+// Read-only view over the points of a figure. Coordinates are addressed
+// through a stride (in floats), so the same view covers interleaved ImVec2
+// storage (stride 2) and separate x/y arrays (stride 1) without copying.
+//
+
+class FigureView
+{
+public: // Construction
+
+  FigureView() = default;
+
+  FigureView(
+      const float *     x,
+      const float *     y,
+      const std::size_t count,
+      const std::size_t stride = 1
+    ) :
+      m_X(x),
+      m_Y(y),
+      m_Count(count),
+      m_Stride(stride)
+  {
+    // Empty
+  }
+
+  FigureView(
+      const std::vector<ImVec2> & points
+    ) :
+      FigureView(points.data(), points.size())
+  {
+    // Empty
+  }
+
+  FigureView(
+      const std::pmr::vector<ImVec2> & points
+    ) :
+      FigureView(points.data(), points.size())
+  {
+    // Empty
+  }
+
+  FigureView(
+      const ImVec2 *    points,
+      const std::size_t count
+    ) :
+      m_X(count ? &points->x : nullptr),
+      m_Y(count ? &points->y : nullptr),
+      m_Count(count),
+      m_Stride(sizeof(ImVec2) / sizeof(float))
+  {
+    // Empty
+  }
+
+public: // Interface
+
+  std::size_t Size() const
+  {
+    return m_Count;
+  }
+
+  bool Empty() const
+  {
+    return m_Count == 0;
+  }
+
+  std::size_t Stride() const
+  {
+    return m_Stride;
+  }
+
+  const float * X() const
+  {
+    return m_X;
+  }
+
+  const float * Y() const
+  {
+    return m_Y;
+  }
+
+  ImVec2 operator[](const std::size_t i) const
+  {
+    return ImVec2{ m_X[i * m_Stride], m_Y[i * m_Stride] };
+  }
+
+  ImVec2 Front() const
+  {
+    return (*this)[0];
+  }
+
+  ImVec2 Back() const
+  {
+    return (*this)[m_Count - 1];
+  }
+
+private: // Members
+
+  const float * m_X      = nullptr;
+  const float * m_Y      = nullptr;
+  std::size_t   m_Count  = 0;
+  std::size_t   m_Stride = 1;
+};
+
+inline std::vector<ImVec2> ToVector(
+    const FigureView points
+  )
+{
+  std::vector<ImVec2> Result;
+  Result.reserve(points.Size());
+
+  for (std::size_t i = 0; i < points.Size(); ++i)
+    Result.push_back(points[i]);
+
+  return Result;
+}
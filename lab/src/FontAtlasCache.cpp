@@ -0,0 +1,313 @@
+#include "FontAtlasCache.h"
+#include "StartupTrace.h"
+
+#include <imgui_internal.h>
+
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+#include <cstring>
+#include <cstdint>
+
+namespace
+{
+
+constexpr char          FONT_CACHE_MAGIC[8] = { 'M', 'F', 'O', 'N', 'T', 'A', 'T', '\0' };
+constexpr std::uint32_t FONT_CACHE_VERSION  = 1;
+
+struct FontCacheHeader
+{
+  char          Magic[8];
+  std::uint32_t Version;
+  std::uint32_t ImGuiVersion;
+  float         SizePixels;
+  std::uint32_t NameLength;
+  std::int32_t  TexWidth;
+  std::int32_t  TexHeight;
+  float         TexUvWhitePixel[2];
+  std::int32_t  PackIdMouseCursors;
+  std::int32_t  PackIdLines;
+  std::uint32_t GlyphCount;
+  std::uint32_t CustomRectCount;
+  float         FontSize;
+  float         Ascent;
+  float         Descent;
+  std::uint32_t EllipsisChar;
+  std::uint32_t Reserved;
+};
+
+static_assert(sizeof(FontCacheHeader) == 76, "Font cache header layout changed");
+
+struct CachedGlyph
+{
+  std::uint32_t Codepoint;
+  float         AdvanceX;
+  float         X0, Y0, X1, Y1;
+  float         U0, V0, U1, V1;
+};
+
+// ImFontAtlasCustomRect without the font pointer, only rects that belong
+// to no font (lines, mouse cursors) are cached
+struct CachedRect
+{
+  std::uint16_t Width, Height;
+  std::uint16_t X, Y;
+  std::uint32_t GlyphId;
+  float         GlyphAdvanceX;
+  float         GlyphOffset[2];
+};
+
+constexpr int TEX_LINES_COUNT = IM_DRAWLIST_TEX_LINES_WIDTH_MAX + 1;
+
+std::string GetCachePath(
+    const FontAtlasSpec & spec,
+    const std::string &   cache_directory
+  )
+{
+  const auto Name = spec.File.empty() ? std::string("default") : std::filesystem::path(spec.File).stem().string();
+
+  return (std::filesystem::path(cache_directory) /
+      (Name + "_" + std::to_string(int(spec.SizePixels * 100)) + "_" + std::to_string(IMGUI_VERSION_NUM) + ".atlas")).string();
+}
+
+ImFont * AddFont(
+    ImFontAtlas &         atlas,
+    const FontAtlasSpec & spec
+  )
+{
+  ImFontConfig Config;
+  Config.SizePixels = spec.SizePixels;
+
+  if (spec.File.empty())
+    return atlas.AddFontDefault(&Config);
+
+  auto * Result = atlas.AddFontFromFileTTF(spec.File.c_str(), spec.SizePixels, &Config);
+
+  if (!Result)
+    throw std::runtime_error("Failed to load font " + spec.File);
+
+  return Result;
+}
+
+template <class T>
+bool ReadArray(
+    std::ifstream &   in,
+    std::vector<T> &  out,
+    const std::size_t count
+  )
+{
+  out.resize(count);
+  return bool(in.read(reinterpret_cast<char *>(out.data()), count * sizeof(T)));
+}
+
+std::unique_ptr<ImFontAtlas> ReadCache(
+    const std::string &   path,
+    const FontAtlasSpec & spec
+  )
+{
+  std::ifstream In(path, std::ios::binary);
+
+  if (!In)
+    return nullptr;
+
+  FontCacheHeader Header;
+
+  if (!In.read(reinterpret_cast<char *>(&Header), sizeof(Header))
+   || std::memcmp(Header.Magic, FONT_CACHE_MAGIC, sizeof(FONT_CACHE_MAGIC)) != 0
+   || Header.Version != FONT_CACHE_VERSION
+   || Header.ImGuiVersion != IMGUI_VERSION_NUM
+   || Header.SizePixels != spec.SizePixels
+   || Header.NameLength != spec.File.size()
+   || Header.TexWidth <= 0
+   || Header.TexHeight <= 0)
+    return nullptr;
+
+  std::string Name(Header.NameLength, '\0');
+  std::vector<CachedGlyph> Glyphs;
+  std::vector<CachedRect> Rects;
+  std::vector<ImVec4> TexUvLines;
+  std::vector<std::uint32_t> Pixels;
+
+  if (!In.read(Name.data(), Name.size()) || Name != spec.File
+   || !ReadArray(In, Glyphs, Header.GlyphCount)
+   || !ReadArray(In, Rects, Header.CustomRectCount)
+   || !ReadArray(In, TexUvLines, TEX_LINES_COUNT)
+   || !ReadArray(In, Pixels, std::size_t(Header.TexWidth) * Header.TexHeight))
+    return nullptr;
+
+  // The font is registered as usual, only the rasterization is skipped
+  auto Result = std::make_unique<ImFontAtlas>();
+  auto * Font = AddFont(*Result, spec);
+
+  Result->TexWidth = Header.TexWidth;
+  Result->TexHeight = Header.TexHeight;
+  Result->TexUvScale = ImVec2(1.0f / Header.TexWidth, 1.0f / Header.TexHeight);
+  Result->TexUvWhitePixel = ImVec2(Header.TexUvWhitePixel[0], Header.TexUvWhitePixel[1]);
+  Result->PackIdMouseCursors = Header.PackIdMouseCursors;
+  Result->PackIdLines = Header.PackIdLines;
+  std::copy(TexUvLines.begin(), TexUvLines.end(), Result->TexUvLines);
+
+  for (const auto & Rect : Rects)
+  {
+    ImFontAtlasCustomRect Custom;
+    Custom.Width = Rect.Width;
+    Custom.Height = Rect.Height;
+    Custom.X = Rect.X;
+    Custom.Y = Rect.Y;
+    Custom.GlyphID = Rect.GlyphId;
+    Custom.GlyphAdvanceX = Rect.GlyphAdvanceX;
+    Custom.GlyphOffset = ImVec2(Rect.GlyphOffset[0], Rect.GlyphOffset[1]);
+    Custom.Font = nullptr;
+    Result->CustomRects.push_back(Custom);
+  }
+
+  // Owned and freed by the atlas
+  Result->TexPixelsRGBA32 = static_cast<unsigned int *>(IM_ALLOC(Pixels.size() * sizeof(std::uint32_t)));
+  std::memcpy(Result->TexPixelsRGBA32, Pixels.data(), Pixels.size() * sizeof(std::uint32_t));
+
+  // As ImFontAtlas::Build() sets the font up before adding its glyphs,
+  // AddGlyph() and SetCurrentFont() read ContainerAtlas
+  ImFontAtlasBuildSetupFont(Result.get(), Font, &Result->ConfigData[0], Header.Ascent, Header.Descent);
+  Font->FontSize = Header.FontSize;
+
+  // Cached glyphs already carry the config adjustments, no config is
+  // passed to apply them twice
+  for (const auto & Glyph : Glyphs)
+    Font->AddGlyph(nullptr, ImWchar(Glyph.Codepoint), Glyph.X0, Glyph.Y0, Glyph.X1, Glyph.Y1, Glyph.U0, Glyph.V0, Glyph.U1, Glyph.V1, Glyph.AdvanceX);
+
+  Font->BuildLookupTable();
+  Font->EllipsisChar = ImWchar(Header.EllipsisChar);
+  Result->TexReady = true;
+
+  return Result;
+}
+
+void WriteCache(
+    const std::string &   path,
+    const FontAtlasSpec & spec,
+    const ImFontAtlas &   atlas
+  )
+{
+  if (atlas.Fonts.Size != 1 || !atlas.TexPixelsRGBA32)
+    return;
+
+  const auto & Font = *atlas.Fonts[0];
+
+  std::vector<CachedRect> Rects;
+
+  for (const auto & Rect : atlas.CustomRects)
+  {
+    // Custom glyphs point into the font, such atlases are not cached
+    if (Rect.Font)
+      return;
+
+    Rects.push_back(CachedRect{ Rect.Width, Rect.Height, Rect.X, Rect.Y, Rect.GlyphID, Rect.GlyphAdvanceX, { Rect.GlyphOffset.x, Rect.GlyphOffset.y } });
+  }
+
+  std::vector<CachedGlyph> Glyphs;
+
+  for (const auto & Glyph : Font.Glyphs)
+    Glyphs.push_back(CachedGlyph{ Glyph.Codepoint, Glyph.AdvanceX, Glyph.X0, Glyph.Y0, Glyph.X1, Glyph.Y1, Glyph.U0, Glyph.V0, Glyph.U1, Glyph.V1 });
+
+  FontCacheHeader Header = {};
+  std::memcpy(Header.Magic, FONT_CACHE_MAGIC, sizeof(FONT_CACHE_MAGIC));
+  Header.Version = FONT_CACHE_VERSION;
+  Header.ImGuiVersion = IMGUI_VERSION_NUM;
+  Header.SizePixels = spec.SizePixels;
+  Header.NameLength = std::uint32_t(spec.File.size());
+  Header.TexWidth = atlas.TexWidth;
+  Header.TexHeight = atlas.TexHeight;
+  Header.TexUvWhitePixel[0] = atlas.TexUvWhitePixel.x;
+  Header.TexUvWhitePixel[1] = atlas.TexUvWhitePixel.y;
+  Header.PackIdMouseCursors = atlas.PackIdMouseCursors;
+  Header.PackIdLines = atlas.PackIdLines;
+  Header.GlyphCount = std::uint32_t(Glyphs.size());
+  Header.CustomRectCount = std::uint32_t(Rects.size());
+  Header.FontSize = Font.FontSize;
+  Header.Ascent = Font.Ascent;
+  Header.Descent = Font.Descent;
+  Header.EllipsisChar = Font.EllipsisChar;
+
+  // Written next to the cache and renamed, a crash never leaves a torn file
+  std::error_code Error;
+  std::filesystem::create_directories(std::filesystem::path(path).parent_path(), Error);
+
+  const auto TempPath = path + ".tmp";
+
+  {
+    std::ofstream Out(TempPath, std::ios::binary | std::ios::trunc);
+    Out.write(reinterpret_cast<const char *>(&Header), sizeof(Header));
+    Out.write(spec.File.data(), spec.File.size());
+    Out.write(reinterpret_cast<const char *>(Glyphs.data()), Glyphs.size() * sizeof(CachedGlyph));
+    Out.write(reinterpret_cast<const char *>(Rects.data()), Rects.size() * sizeof(CachedRect));
+    Out.write(reinterpret_cast<const char *>(atlas.TexUvLines), TEX_LINES_COUNT * sizeof(ImVec4));
+    Out.write(reinterpret_cast<const char *>(atlas.TexPixelsRGBA32), std::size_t(atlas.TexWidth) * atlas.TexHeight * sizeof(std::uint32_t));
+
+    if (!Out)
+    {
+      std::cerr << "Font atlas cache: Failed to write " << TempPath << std::endl;
+      return;
+    }
+  }
+
+  std::filesystem::rename(TempPath, path, Error);
+
+  if (Error)
+    std::cerr << "Font atlas cache: Failed to write " << path << ": " << Error.message() << std::endl;
+}
+
+} // namespace
+
+//
+// Interface
+//
+
+void FontAtlasLoader::Start(
+    const FontAtlasSpec & spec,
+    const std::string &   cache_directory
+  )
+{
+  m_Future = std::async(std::launch::async, &FontAtlasLoader::Load, spec, cache_directory);
+}
+
+FontAtlasBuild FontAtlasLoader::Get()
+{
+  return m_Future.get();
+}
+
+//
+// Static service
+//
+
+FontAtlasBuild FontAtlasLoader::Load(
+    const FontAtlasSpec & spec,
+    const std::string &   cache_directory
+  )
+{
+  const auto Start = StartupTrace::Clock::now();
+  const auto Path = GetCachePath(spec, cache_directory);
+
+  FontAtlasBuild Result;
+  Result.Atlas = ReadCache(Path, spec);
+  Result.FromCache = Result.Atlas != nullptr;
+
+  if (!Result.Atlas)
+  {
+    Result.Atlas = std::make_unique<ImFontAtlas>();
+    AddFont(*Result.Atlas, spec);
+
+    // Builds the atlas and expands it to the RGBA pixels the Vulkan
+    // backend uploads, both off the main thread
+    unsigned char * Pixels = nullptr;
+    int Width = 0;
+    int Height = 0;
+    Result.Atlas->GetTexDataAsRGBA32(&Pixels, &Width, &Height);
+
+    WriteCache(Path, spec, *Result.Atlas);
+  }
+
+  StartupTrace::Instance().Add(Result.FromCache ? "Font atlas (from cache)" : "Font atlas (rasterized)", Start, StartupTrace::Clock::now());
+  return Result;
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <imgui.h>
+
+#include <string>
+#include <memory>
+#include <future>
+
+//
+// Font atlas for the ImGui context, built on a worker thread while the
+// window and the device are set up.
+//
+// The rasterized atlas (RGBA pixels, glyph table and the custom rects
+// ImGui takes its line and cursor textures from) is cached on disk, keyed
+// by font, size and IMGUI_VERSION_NUM, so a warm start reads it back
+// instead of running the rasterizer. Unreadable or stale cache files are
+// rebuilt.
+//
+// The format mirrors ImGui internals rather than a public API: the RGBA32
+// pixels (TexPixelsRGBA32), TexUvWhitePixel, TexUvLines, PackIdLines and
+// PackIdMouseCursors, the custom rects those ids index, and the font setup
+// of ImFontAtlasBuildSetupFont. A cache written by another ImGui version
+// (IMGUI_VERSION_NUM in the header and the file name) is thrown away.
+//
+
+struct FontAtlasSpec
+{
+  std::string File;              // TTF file, empty for the embedded default font
+  float       SizePixels = 13;
+};
+
+struct FontAtlasBuild
+{
+  std::unique_ptr<ImFontAtlas> Atlas;
+  bool                         FromCache = false;
+};
+
+class FontAtlasLoader
+{
+public: // Interface
+
+  void Start(
+      const FontAtlasSpec & spec,
+      const std::string &   cache_directory
+    );
+
+  // Waits for the worker, rethrows its errors
+  FontAtlasBuild Get();
+
+private: // Static service
+
+  static FontAtlasBuild Load(
+      const FontAtlasSpec & spec,
+      const std::string &   cache_directory
+    );
+
+private: // Members
+
+  std::future<FontAtlasBuild> m_Future;
+};
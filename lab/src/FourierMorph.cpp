@@ -0,0 +1,142 @@
+#include "FourierMorph.h"
+
+#include <algorithm>
+
+namespace
+{
+
+// `count` samples taken uniformly by index, so the point matching survives
+// the resampling. A closed figure is sampled as a periodic sequence
+// without its repeated last point.
+std::vector<Complex> Resample(
+    const FigureView  points,
+    const std::size_t count,
+    const bool        closed
+  )
+{
+  const auto Step = double(points.Size() - 1) / (closed ? count : count - 1);
+
+  std::vector<Complex> Result;
+  Result.reserve(count);
+
+  for (std::size_t k = 0; k < count; ++k)
+  {
+    const auto Position = k * Step;
+    const auto i = std::min(std::size_t(Position), points.Size() - 2);
+    const auto t = Position - i;
+
+    const auto a = points[i];
+    const auto b = points[i + 1];
+    Result.emplace_back(a.x + (b.x - a.x) * t, a.y + (b.y - a.y) * t);
+  }
+
+  return Result;
+}
+
+} // namespace
+
+//
+// Interface
+//
+
+void FourierMorph::Build(
+    const FigureView first,
+    const FigureView second,
+    const bool       closed
+  )
+{
+  Reset();
+
+  if (first.Size() < 3 || first.Size() != second.Size())
+    return;
+
+  m_Closed = closed;
+
+  const auto Segments = first.Size() - 1;
+
+  if (m_Closed)
+  {
+    const auto Count = std::clamp(NextPowerOfTwo(Segments), MIN_SAMPLES, MAX_SAMPLES);
+    m_First = Resample(first, Count, true);
+    m_Second = Resample(second, Count, true);
+  }
+  else
+  {
+    // p0 .. pn, pn-1 .. p1: continuous when repeated, so the spectrum decays
+    // as fast as the figure is smooth
+    const auto Count = std::clamp(NextPowerOfTwo(2 * Segments), MIN_SAMPLES, MAX_SAMPLES);
+
+    for (auto [Figure, Spectrum] : { std::pair{ first, &m_First }, std::pair{ second, &m_Second } })
+    {
+      *Spectrum = Resample(Figure, Count / 2 + 1, false);
+
+      for (std::size_t k = Count / 2 - 1; k > 0; --k)
+        Spectrum->push_back((*Spectrum)[k]);
+    }
+  }
+
+  Fft(m_First);
+  Fft(m_Second);
+}
+
+void FourierMorph::Reset()
+{
+  m_First.clear();
+  m_Second.clear();
+  m_Closed = false;
+}
+
+std::vector<ImVec2> FourierMorph::Get(
+    const float       t,
+    const std::size_t coefficients
+  ) const
+{
+  if (IsEmpty())
+    return {};
+
+  const auto n = m_First.size();
+  const auto Coefficients = std::clamp<std::size_t>(coefficients, 1, GetMaxCoefficients());
+  const auto m = std::clamp(NextPowerOfTwo(SAMPLES_PER_COEFFICIENT * Coefficients), MIN_SAMPLES, n);
+
+  // The inverse transform divides by its own size
+  const auto Scale = double(m) / n;
+
+  std::vector<Complex> Spectrum(m);
+
+  for (std::size_t k = 0; k <= Coefficients; ++k)
+  {
+    const auto Positive = m_First[k] + (m_Second[k] - m_First[k]) * double(t);
+    Spectrum[k] = Positive * Scale;
+
+    if (k > 0)
+    {
+      const auto Negative = m_First[n - k] + (m_Second[n - k] - m_First[n - k]) * double(t);
+      Spectrum[m - k] = Negative * Scale;
+    }
+  }
+
+  Fft(Spectrum, true);
+
+  const auto Count = m_Closed ? m : m / 2 + 1;
+
+  std::vector<ImVec2> Result;
+  Result.reserve(Count + 1);
+
+  for (std::size_t k = 0; k < Count; ++k)
+    Result.push_back(ImVec2{ float(Spectrum[k].real()), float(Spectrum[k].imag()) });
+
+  if (m_Closed)
+    Result.push_back(Result.front());
+
+  return Result;
+}
+
+bool FourierMorph::IsEmpty() const
+{
+  return m_First.empty();
+}
+
+std::size_t FourierMorph::GetMaxCoefficients() const
+{
+  return IsEmpty() ? 0 : m_First.size() / 2 - 1;
+}
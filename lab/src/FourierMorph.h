@@ -0,0 +1,57 @@
+#pragma once
+
+#include "FigureView.h"
+#include "Fft.h"
+
+#include <imgui.h>
+#include <vector>
+#include <cstddef>
+
+//
+// Morphing in the frequency domain.
+//
+// Both matched figures are resampled to a power-of-two count and turned
+// into Fourier descriptors once. A frame interpolates the lowest
+// frequencies and reconstructs them with an inverse FFT, whose size
+// follows the coefficient count, so fewer coefficients are both smoother
+// and cheaper. Open figures are mirrored into a closed out-and-back path
+// first to avoid ringing at the ends.
+//
+
+class FourierMorph
+{
+public: // Interface
+
+  // The figures must have the same size, point i of one matching point i of
+  // the other. Closed figures repeat the first point at the end.
+  void Build(
+      const FigureView first,
+      const FigureView second,
+      const bool       closed
+    );
+
+  void Reset();
+
+  // Shape at `t` (0 - first figure, 1 - second one) reconstructed from the
+  // frequencies -coefficients..coefficients
+  std::vector<ImVec2> Get(
+      const float       t,
+      const std::size_t coefficients
+    ) const;
+
+  bool IsEmpty() const;
+
+  std::size_t GetMaxCoefficients() const;
+
+private: // Constants
+
+  static constexpr std::size_t MIN_SAMPLES             = 64;
+  static constexpr std::size_t MAX_SAMPLES             = 1 << 17;
+  static constexpr std::size_t SAMPLES_PER_COEFFICIENT = 8;
+
+private: // Members
+
+  std::vector<Complex> m_First;
+  std::vector<Complex> m_Second;
+  bool                 m_Closed = false;
+};
@@ -0,0 +1,147 @@
+#include "FrameArena.h"
+
+#include <algorithm>
+#include <cstdint>
+
+namespace
+{
+
+thread_local FrameArena * t_Current = nullptr;
+
+} // namespace
+
+//
+// Construction / Destruction
+//
+
+FrameArena::FrameArena(
+    const std::size_t capacity
+  ) :
+    m_Block(std::make_unique<std::byte[]>(capacity)),
+    m_Capacity(capacity)
+{
+  // The spill list never grows in a steady state frame
+  m_Spills.reserve(8);
+}
+
+//
+// Interface
+//
+
+void FrameArena::Reset()
+{
+  if (!m_Spills.empty())
+  {
+    // Room for the frame that spilled plus some headroom, one allocation
+    // instead of one per spill every frame
+    m_Capacity = std::max(m_Capacity * 2, m_Used + m_Used / 2);
+    m_Block = std::make_unique<std::byte[]>(m_Capacity);
+    m_Spills.clear();
+  }
+
+  m_Offset = 0;
+  m_Used = 0;
+}
+
+std::size_t FrameArena::GetUsed() const
+{
+  return m_Used;
+}
+
+std::size_t FrameArena::GetCapacity() const
+{
+  return m_Capacity;
+}
+
+void FrameArena::SetCurrent(
+    FrameArena * arena
+  )
+{
+  t_Current = arena;
+}
+
+std::pmr::memory_resource & FrameArena::GetResource()
+{
+  if (t_Current)
+    return *t_Current;
+
+  return *std::pmr::new_delete_resource();
+}
+
+//
+// std::pmr::memory_resource
+//
+
+void * FrameArena::do_allocate(
+    std::size_t bytes,
+    std::size_t alignment
+  )
+{
+  const auto Before = m_Offset;
+
+  if (auto * Result = Bump(m_Block.get(), m_Capacity, m_Offset, bytes, alignment))
+  {
+    m_Used += m_Offset - Before;
+    return Result;
+  }
+
+  if (!m_Spills.empty())
+  {
+    auto & Last = m_Spills.back();
+    const auto SpillBefore = Last.Offset;
+
+    if (auto * Result = Bump(Last.Block.get(), Last.Capacity, Last.Offset, bytes, alignment))
+    {
+      m_Used += Last.Offset - SpillBefore;
+      return Result;
+    }
+  }
+
+  Spill New;
+  New.Capacity = std::max(m_Capacity, bytes + alignment);
+  New.Block = std::make_unique<std::byte[]>(New.Capacity);
+  m_Spills.push_back(std::move(New));
+
+  auto & Last = m_Spills.back();
+  auto * Result = Bump(Last.Block.get(), Last.Capacity, Last.Offset, bytes, alignment);
+  m_Used += Last.Offset;
+  return Result;
+}
+
+void FrameArena::do_deallocate(
+    [[maybe_unused]] void *      ptr,
+    [[maybe_unused]] std::size_t bytes,
+    [[maybe_unused]] std::size_t alignment
+  )
+{
+  // Released by Reset()
+}
+
+bool FrameArena::do_is_equal(
+    const std::pmr::memory_resource & other
+  ) const noexcept
+{
+  return this == &other;
+}
+
+//
+// Service
+//
+
+void * FrameArena::Bump(
+    std::byte *       block,
+    const std::size_t capacity,
+    std::size_t &     offset,
+    const std::size_t bytes,
+    const std::size_t alignment
+  )
+{
+  const auto Address = reinterpret_cast<std::uintptr_t>(block) + offset;
+  const auto Padding = (alignment - Address % alignment) % alignment;
+
+  if (offset + Padding + bytes > capacity)
+    return nullptr;
+
+  offset += Padding + bytes;
+  return block + offset - bytes;
+}
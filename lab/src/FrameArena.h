@@ -0,0 +1,102 @@
+#pragma once
+
+#include <memory_resource>
+#include <memory>
+#include <vector>
+#include <cstddef>
+
+//
+// Bump allocator for the temporaries of one frame (splines, morphs,
+// resampled copies). The application owns it and resets it at the start
+// of every frame; deallocation is a no-op, everything is released by the
+// reset.
+//
+// A frame that does not fit spills into extra blocks, the next reset
+// replaces them with one block large enough for that frame, so in steady
+// state the temporaries drawn from the arena never reach the system
+// allocator. That covers only what is allocated through GetResource():
+// the worker threads' results and the std::vector members of windows
+// still use the heap.
+//
+// The arena is bound to the thread that made it current (the main
+// thread), GetResource() on any other thread falls back to the default
+// heap resource.
+//
+
+class FrameArena :
+  public std::pmr::memory_resource
+{
+public: // Construction / Destruction
+
+  explicit FrameArena(
+      const std::size_t capacity = DEFAULT_CAPACITY
+    );
+
+  FrameArena(const FrameArena &) = delete;
+  FrameArena & operator=(const FrameArena &) = delete;
+
+public: // Interface
+
+  void Reset();
+
+  // Bytes handed out since the last reset, padding included
+  std::size_t GetUsed() const;
+
+  std::size_t GetCapacity() const;
+
+  // Makes the arena current for the calling thread, nullptr unbinds it
+  static void SetCurrent(
+      FrameArena * arena
+    );
+
+  // The current thread's frame arena, or the heap outside of a frame
+  static std::pmr::memory_resource & GetResource();
+
+private: // std::pmr::memory_resource
+
+  void * do_allocate(
+      std::size_t bytes,
+      std::size_t alignment
+    ) override;
+
+  void do_deallocate(
+      void *      ptr,
+      std::size_t bytes,
+      std::size_t alignment
+    ) override;
+
+  bool do_is_equal(
+      const std::pmr::memory_resource & other
+    ) const noexcept override;
+
+private: // Service
+
+  void * Bump(
+      std::byte *       block,
+      const std::size_t capacity,
+      std::size_t &     offset,
+      const std::size_t bytes,
+      const std::size_t alignment
+    );
+
+private: // Types
+
+  struct Spill
+  {
+    std::unique_ptr<std::byte[]> Block;
+    std::size_t                  Capacity = 0;
+    std::size_t                  Offset   = 0;
+  };
+
+public: // Constants
+
+  static constexpr std::size_t DEFAULT_CAPACITY = 1 << 20;
+
+private: // Members
+
+  std::unique_ptr<std::byte[]> m_Block;
+  std::size_t                  m_Capacity = 0;
+  std::size_t                  m_Offset   = 0;
+  std::vector<Spill>           m_Spills;
+  std::size_t                  m_Used     = 0;
+};
@@ -0,0 +1,252 @@
+#include "FrameCost.h"
+#include "IWindow.h"
+
+#include <algorithm>
+#include <fstream>
+#include <stdexcept>
+
+#ifdef LAB_TRACK_ALLOCATIONS
+#include <new>
+#include <cstdlib>
+#endif // LAB_TRACK_ALLOCATIONS
+
+#ifdef LAB_TRACK_ALLOCATIONS
+
+namespace
+{
+
+thread_local FrameCost::Scope * t_Scope = nullptr;
+
+void CountAllocation(
+    const std::size_t size
+  )
+{
+  if (t_Scope)
+  {
+    ++t_Scope->m_Sample.Allocations;
+    t_Scope->m_Sample.Bytes += size;
+  }
+}
+
+void CountFree(
+    void * ptr
+  )
+{
+  if (t_Scope && ptr)
+    ++t_Scope->m_Sample.Frees;
+}
+
+void * Allocate(
+    std::size_t size
+  )
+{
+  CountAllocation(size);
+
+  if (void * Result = std::malloc(size ? size : 1))
+    return Result;
+
+  throw std::bad_alloc();
+}
+
+void * AllocateAligned(
+    std::size_t           size,
+    const std::align_val_t alignment
+  )
+{
+  CountAllocation(size);
+
+  const auto Alignment = static_cast<std::size_t>(alignment);
+
+#ifdef _WIN32
+  void * Result = _aligned_malloc(size ? size : 1, Alignment);
+#else
+  // aligned_alloc wants a multiple of the alignment
+  void * Result = std::aligned_alloc(Alignment, ((size ? size : 1) + Alignment - 1) / Alignment * Alignment);
+#endif
+
+  if (Result)
+    return Result;
+
+  throw std::bad_alloc();
+}
+
+void Free(
+    void * ptr
+  )
+{
+  CountFree(ptr);
+  std::free(ptr);
+}
+
+void FreeAligned(
+    void * ptr
+  )
+{
+  CountFree(ptr);
+#ifdef _WIN32
+  _aligned_free(ptr);
+#else
+  std::free(ptr);
+#endif
+}
+
+} // namespace
+
+//
+// Global allocation functions
+//
+
+// Every replaceable form is defined, so no allocation reaches the default
+// aligned allocator and is then released by FreeAligned(), or the reverse
+
+void * operator new(std::size_t size) { return Allocate(size); }
+void * operator new[](std::size_t size) { return Allocate(size); }
+void * operator new(std::size_t size, const std::nothrow_t &) noexcept { try { return Allocate(size); } catch (...) { return nullptr; } }
+void * operator new[](std::size_t size, const std::nothrow_t &) noexcept { try { return Allocate(size); } catch (...) { return nullptr; } }
+void * operator new(std::size_t size, std::align_val_t alignment) { return AllocateAligned(size, alignment); }
+void * operator new[](std::size_t size, std::align_val_t alignment) { return AllocateAligned(size, alignment); }
+void * operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t &) noexcept { try { return AllocateAligned(size, alignment); } catch (...) { return nullptr; } }
+void * operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t &) noexcept { try { return AllocateAligned(size, alignment); } catch (...) { return nullptr; } }
+
+void operator delete(void * ptr) noexcept { Free(ptr); }
+void operator delete[](void * ptr) noexcept { Free(ptr); }
+void operator delete(void * ptr, std::size_t) noexcept { Free(ptr); }
+void operator delete[](void * ptr, std::size_t) noexcept { Free(ptr); }
+void operator delete(void * ptr, const std::nothrow_t &) noexcept { Free(ptr); }
+void operator delete[](void * ptr, const std::nothrow_t &) noexcept { Free(ptr); }
+void operator delete(void * ptr, std::align_val_t) noexcept { FreeAligned(ptr); }
+void operator delete[](void * ptr, std::align_val_t) noexcept { FreeAligned(ptr); }
+void operator delete(void * ptr, std::size_t, std::align_val_t) noexcept { FreeAligned(ptr); }
+void operator delete[](void * ptr, std::size_t, std::align_val_t) noexcept { FreeAligned(ptr); }
+void operator delete(void * ptr, std::align_val_t, const std::nothrow_t &) noexcept { FreeAligned(ptr); }
+void operator delete[](void * ptr, std::align_val_t, const std::nothrow_t &) noexcept { FreeAligned(ptr); }
+
+#endif // LAB_TRACK_ALLOCATIONS
+
+//
+// Scope
+//
+
+FrameCost::Scope::Scope(
+    const IWindow & window
+  ) :
+    m_Window(window)
+{
+#ifdef LAB_TRACK_ALLOCATIONS
+  m_Previous = t_Scope;
+  t_Scope = this;
+  m_Start = std::chrono::steady_clock::now();
+#endif // LAB_TRACK_ALLOCATIONS
+}
+
+FrameCost::Scope::~Scope()
+{
+#ifdef LAB_TRACK_ALLOCATIONS
+  m_Sample.Ms = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - m_Start).count();
+
+  // The bookkeeping below is charged to the enclosing scope, if any
+  t_Scope = m_Previous;
+  FrameCost::Instance().Add(m_Window, m_Sample);
+#endif // LAB_TRACK_ALLOCATIONS
+}
+
+//
+// Interface
+//
+
+FrameCost & FrameCost::Instance()
+{
+  static FrameCost Cost;
+  return Cost;
+}
+
+void FrameCost::EndFrame()
+{
+  for (auto & Entry : m_Entries)
+  {
+    Entry.Last = Entry.Current;
+    Entry.Current = FrameCostSample{};
+
+    if (Entry.Last.Allocations == 0 && Entry.Last.Ms == 0)
+      continue;
+
+    ++Entry.Frames;
+    Entry.Total.Allocations += Entry.Last.Allocations;
+    Entry.Total.Frees += Entry.Last.Frees;
+    Entry.Total.Bytes += Entry.Last.Bytes;
+    Entry.Total.Ms += Entry.Last.Ms;
+    Entry.MaxMs = std::max(Entry.MaxMs, Entry.Last.Ms);
+  }
+}
+
+void FrameCost::Reset()
+{
+  for (auto & Entry : m_Entries)
+  {
+    Entry.Total = FrameCostSample{};
+    Entry.Frames = 0;
+    Entry.MaxMs = 0;
+  }
+}
+
+const std::vector<FrameCost::Entry> & FrameCost::GetEntries() const
+{
+  return m_Entries;
+}
+
+void FrameCost::Export(
+    const std::string & path
+  ) const
+{
+  std::ofstream Out(path, std::ios::trunc);
+
+  if (!Out)
+    throw std::runtime_error("Failed to open " + path);
+
+  Out << "window,frames,allocations_per_frame,frees_per_frame,bytes_per_frame,ms_per_frame,max_ms,last_allocations,last_bytes,last_ms\n";
+
+  for (const auto & Entry : m_Entries)
+  {
+    const double Frames = Entry.Frames ? double(Entry.Frames) : 1.0;
+
+    Out << '"' << Entry.Name << '"' << ','
+        << Entry.Frames << ','
+        << Entry.Total.Allocations / Frames << ','
+        << Entry.Total.Frees / Frames << ','
+        << Entry.Total.Bytes / Frames << ','
+        << Entry.Total.Ms / Frames << ','
+        << Entry.MaxMs << ','
+        << Entry.Last.Allocations << ','
+        << Entry.Last.Bytes << ','
+        << Entry.Last.Ms << '\n';
+  }
+
+  if (!Out)
+    throw std::runtime_error("Failed to write " + path);
+}
+
+//
+// Service
+//
+
+void FrameCost::Add(
+    const IWindow &         window,
+    const FrameCostSample & sample
+  )
+{
+  auto Found = std::find_if(m_Entries.begin(), m_Entries.end(), [&window](const Entry & entry) { return entry.Window == &window; });
+
+  if (Found == m_Entries.end())
+  {
+    Entry New;
+    New.Window = &window;
+    New.Name = window.GetWindowNameID();
+    New.Name.erase(std::min(New.Name.size(), New.Name.find("###")));
+    Found = m_Entries.insert(m_Entries.end(), std::move(New));
+  }
+
+  Found->Current.Allocations += sample.Allocations;
+  Found->Current.Frees += sample.Frees;
+  Found->Current.Bytes += sample.Bytes;
+  Found->Current.Ms += sample.Ms;
+}
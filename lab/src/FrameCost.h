@@ -0,0 +1,104 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cstddef>
+
+class IWindow;
+
+//
+// Per-window frame cost accounting, compiled in with LAB_TRACK_ALLOCATIONS.
+//
+// The instrumentation build replaces the global allocation functions; an
+// allocation made on a thread while a Scope is open is counted against
+// the innermost scope, so IWindow::Show attributes ImGui's window setup
+// and everything UpdateFrameData allocates to the window. Allocations on
+// worker threads are not attributed. Without the define Scope does nothing
+// and the allocator is untouched.
+//
+
+struct FrameCostSample
+{
+  std::size_t Allocations = 0;
+  std::size_t Frees       = 0;
+  std::size_t Bytes       = 0;
+  float       Ms          = 0;
+};
+
+class FrameCost
+{
+public: // Types
+
+  struct Entry
+  {
+    const IWindow * Window = nullptr;
+    std::string     Name;
+    FrameCostSample Current;     // Accumulated this frame
+    FrameCostSample Last;        // Previous frame
+    FrameCostSample Total;
+    std::size_t     Frames = 0;  // Frames the window was shown
+    float           MaxMs  = 0;
+  };
+
+  // Tags the allocations of the current thread with a window
+  class Scope
+  {
+  public: // Construction / Destruction
+
+    explicit Scope(
+        const IWindow & window
+      );
+
+    ~Scope();
+
+    Scope(const Scope &) = delete;
+    Scope & operator=(const Scope &) = delete;
+
+  public: // Members, counted by the allocation functions
+
+    FrameCostSample m_Sample;
+
+  private: // Members
+
+    const IWindow &                       m_Window;
+    Scope *                               m_Previous = nullptr;
+    std::chrono::steady_clock::time_point m_Start;
+  };
+
+public: // Interface
+
+  static FrameCost & Instance();
+
+  static constexpr bool IsEnabled()
+  {
+#ifdef LAB_TRACK_ALLOCATIONS
+    return true;
+#else
+    return false;
+#endif
+  }
+
+  // Moves this frame's samples to Last and the totals
+  void EndFrame();
+
+  void Reset();
+
+  const std::vector<Entry> & GetEntries() const;
+
+  // Writes one row per window, throws on failure
+  void Export(
+      const std::string & path
+    ) const;
+
+private: // Service
+
+  void Add(
+      const IWindow &         window,
+      const FrameCostSample & sample
+    );
+
+private: // Members
+
+  std::vector<Entry> m_Entries;
+};
@@ -0,0 +1,114 @@
+#include "FrameCostWindow.h"
+#include "FrameCost.h"
+
+#include <imgui.h>
+
+#include <algorithm>
+#include <vector>
+#include <exception>
+
+//
+// Construction
+//
+
+FrameCostWindow::FrameCostWindow(
+    const std::string & window_name
+  ) :
+    m_WindowName(window_name)
+{
+  const std::string DefaultPath = "frame_costs.csv";
+  DefaultPath.copy(m_ExportPath.data(), m_ExportPath.size() - 1);
+}
+
+//
+// IWindow
+//
+
+std::string_view FrameCostWindow::GetWindowName() const
+{
+  return m_WindowName;
+}
+
+void FrameCostWindow::UpdateFrameData()
+{
+  if (!FrameCost::IsEnabled())
+  {
+    ImGui::TextWrapped("Frame cost accounting is compiled in with LAB_TRACK_ALLOCATIONS.");
+    return;
+  }
+
+  auto & Cost = FrameCost::Instance();
+
+  if (ImGui::Button("Reset"))
+    Cost.Reset();
+
+  ImGui::SameLine();
+  ImGui::Checkbox("Sort by bytes", &m_SortByBytes);
+
+  ImGui::InputText("##ExportPath", m_ExportPath.data(), m_ExportPath.size());
+  ImGui::SameLine();
+
+  if (ImGui::Button("Export CSV"))
+  {
+    try
+    {
+      Cost.Export(m_ExportPath.data());
+      m_ExportStatus = std::string("Exported to ") + m_ExportPath.data();
+    }
+    catch (const std::exception & ex)
+    {
+      m_ExportStatus = ex.what();
+    }
+  }
+
+  if (!m_ExportStatus.empty())
+    ImGui::TextUnformatted(m_ExportStatus.c_str());
+
+  // This window is listed as well, the sorting below is its own cost
+  std::vector<const FrameCost::Entry *> Rows;
+
+  for (const auto & Entry : Cost.GetEntries())
+    Rows.push_back(&Entry);
+
+  const auto PerFrame = [](const FrameCost::Entry & entry, const std::size_t total) { return entry.Frames ? float(total) / entry.Frames : 0.0f; };
+
+  std::sort(Rows.begin(), Rows.end(), [&](const FrameCost::Entry * a, const FrameCost::Entry * b)
+    {
+      return m_SortByBytes
+        ? PerFrame(*a, a->Total.Bytes) > PerFrame(*b, b->Total.Bytes)
+        : PerFrame(*a, a->Total.Allocations) > PerFrame(*b, b->Total.Allocations);
+    });
+
+  if (!ImGui::BeginTable("FrameCosts", 7, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg))
+    return;
+
+  ImGui::TableSetupColumn("Window");
+  ImGui::TableSetupColumn("Allocs");
+  ImGui::TableSetupColumn("Bytes");
+  ImGui::TableSetupColumn("ms");
+  ImGui::TableSetupColumn("Allocs/frame");
+  ImGui::TableSetupColumn("Bytes/frame");
+  ImGui::TableSetupColumn("ms/frame (max)");
+  ImGui::TableHeadersRow();
+
+  for (const auto * Entry : Rows)
+  {
+    ImGui::TableNextRow();
+    ImGui::TableNextColumn();
+    ImGui::TextUnformatted(Entry->Name.c_str());
+    ImGui::TableNextColumn();
+    ImGui::Text("%d", int(Entry->Last.Allocations));
+    ImGui::TableNextColumn();
+    ImGui::Text("%d", int(Entry->Last.Bytes));
+    ImGui::TableNextColumn();
+    ImGui::Text("%.3f", Entry->Last.Ms);
+    ImGui::TableNextColumn();
+    ImGui::Text("%.1f", PerFrame(*Entry, Entry->Total.Allocations));
+    ImGui::TableNextColumn();
+    ImGui::Text("%.0f", PerFrame(*Entry, Entry->Total.Bytes));
+    ImGui::TableNextColumn();
+    ImGui::Text("%.3f (%.3f)", Entry->Frames ? Entry->Total.Ms / Entry->Frames : 0.0f, Entry->MaxMs);
+  }
+
+  ImGui::EndTable();
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include "IWindow.h"
+
+#include <string>
+#include <array>
+
+//
+// Table of the per-window allocations, bytes and CPU time collected by
+// FrameCost, worst offenders first, with a CSV export.
+//
+
+class FrameCostWindow :
+  public IWindow
+{
+public: // Construction
+
+  FrameCostWindow(
+      const std::string & window_name
+    );
+
+protected: // IWindow
+
+  std::string_view GetWindowName() const override;
+
+  void UpdateFrameData() override;
+
+private: // Members
+
+  std::string           m_WindowName;
+  std::array<char, 256> m_ExportPath{};
+  std::string           m_ExportStatus;
+  bool                  m_SortByBytes = true;
+};
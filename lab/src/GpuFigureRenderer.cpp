@@ -0,0 +1,585 @@
+#include "GpuFigureRenderer.h"
+#include "ImVecUtils.h"
+
+#include <algorithm>
+#include <iostream>
+
+//
+// Interface
+//
+
+GpuFigureRenderer & GpuFigureRenderer::Instance()
+{
+  static GpuFigureRenderer Renderer;
+  return Renderer;
+}
+
+void GpuFigureRenderer::Init(
+    const InitInfo & info
+  )
+{
+  m_Info = info;
+  m_Streams.resize(m_Info.ImageCount + 3);
+
+  CreatePipeline();
+}
+
+void GpuFigureRenderer::Shutdown()
+{
+  for (auto & [Handle, Resource] : m_Buffers)
+    Destroy(Resource);
+
+  for (auto & Retired : m_Retired)
+    Destroy(Retired.Resource);
+
+  for (auto & Stream : m_Streams)
+    DestroyHostBuffer(m_Info.Device, m_Info.Allocator, Stream);
+
+  m_Buffers.clear();
+  m_Retired.clear();
+  m_Streams.clear();
+  m_Commands.clear();
+
+  if (m_Pipeline)
+    vkDestroyPipeline(m_Info.Device, m_Pipeline, m_Info.Allocator);
+
+  if (m_PipelineLayout)
+    vkDestroyPipelineLayout(m_Info.Device, m_PipelineLayout, m_Info.Allocator);
+
+  m_Pipeline = VK_NULL_HANDLE;
+  m_PipelineLayout = VK_NULL_HANDLE;
+  m_IsAvailable = false;
+}
+
+void GpuFigureRenderer::SetImageCount(
+    const std::uint32_t image_count
+  )
+{
+  m_Info.ImageCount = image_count;
+
+  // No frame is in flight, the streams past the new count are not read
+  for (auto i = std::size_t(image_count) + 3; i < m_Streams.size(); ++i)
+    DestroyHostBuffer(m_Info.Device, m_Info.Allocator, m_Streams[i]);
+
+  m_Streams.resize(image_count + 3);
+}
+
+bool GpuFigureRenderer::IsAvailable() const
+{
+  return m_IsAvailable;
+}
+
+void GpuFigureRenderer::BeginFrame(
+    VkCommandBuffer    command_buffer,
+    const ImDrawData * draw_data
+  )
+{
+  m_CommandBuffer = command_buffer;
+  m_DrawData = draw_data;
+  ++m_Frame;
+
+  // A retired buffer may still be read by any frame in flight
+  while (!m_Retired.empty() && m_Retired.front().Frame + m_Info.ImageCount + 1 < m_Frame)
+  {
+    Destroy(m_Retired.front().Resource);
+    m_Retired.pop_front();
+  }
+}
+
+void GpuFigureRenderer::EndFrame()
+{
+  m_CommandBuffer = VK_NULL_HANDLE;
+  m_DrawData = nullptr;
+  m_Commands.clear();
+  m_StreamUsed = 0;
+}
+
+GpuFigureRenderer::Handle GpuFigureRenderer::Create()
+{
+  const auto Result = m_NextHandle++;
+  m_Buffers.emplace(Result, Buffer{});
+  return Result;
+}
+
+bool GpuFigureRenderer::Upload(
+    const Handle     handle,
+    const FigureView points
+  )
+{
+  const auto Found = m_Buffers.find(handle);
+
+  if (Found == m_Buffers.end())
+    return false;
+
+  Retire(Found->second);
+  Found->second = Buffer{};
+
+  if (!m_IsAvailable || points.Size() < 2)
+    return false;
+
+  // Written once per edit, host visible memory avoids a staging copy
+  Buffer Result;
+  Result.Count = std::uint32_t(points.Size());
+
+  try
+  {
+    Result.Vertices = CreateHostBuffer(m_Info.PhysicalDevice, m_Info.Device, m_Info.Allocator, points.Size() * sizeof(ImVec2), VK_BUFFER_USAGE_VERTEX_BUFFER_BIT);
+  }
+  catch (const std::exception & ex)
+  {
+    // Out of memory for a huge figure, it is drawn on the CPU
+    std::cerr << "GPU figure renderer: " << ex.what() << std::endl;
+    return false;
+  }
+
+  auto * Vertices = static_cast<ImVec2 *>(Result.Vertices.Data);
+
+  for (std::size_t i = 0; i < points.Size(); ++i)
+    Vertices[i] = points[i];
+
+  Found->second = Result;
+  return true;
+}
+
+void GpuFigureRenderer::Release(
+    const Handle handle
+  )
+{
+  const auto Found = m_Buffers.find(handle);
+
+  if (Found == m_Buffers.end())
+    return;
+
+  Retire(Found->second);
+  m_Buffers.erase(Found);
+}
+
+bool GpuFigureRenderer::CanDraw() const
+{
+  if (!m_IsAvailable)
+    return false;
+
+  // Platform windows are recorded into their own command buffers
+  return ImGui::GetWindowViewport() == ImGui::GetMainViewport();
+}
+
+bool GpuFigureRenderer::Draw(
+    ImDrawList *  draw_list,
+    const Handle  handle,
+    const ImVec2  origin,
+    const float   zoom,
+    const ImU32   color,
+    const float   thickness
+  )
+{
+  const auto Found = m_Buffers.find(handle);
+
+  if (Found == m_Buffers.end() || !Found->second.Vertices.Buffer)
+    return false;
+
+  return DrawBuffer(draw_list, Found->second.Vertices.Buffer, Found->second.Count, origin, zoom, color, thickness);
+}
+
+bool GpuFigureRenderer::DrawBuffer(
+    ImDrawList *        draw_list,
+    VkBuffer            buffer,
+    const std::uint32_t count,
+    const ImVec2        origin,
+    const float         zoom,
+    const ImU32         color,
+    const float         thickness
+  )
+{
+  if (!CanDraw() || !buffer || count < 2)
+    return false;
+
+  return AddCommand(draw_list, buffer, 0, count, origin, zoom, color, thickness);
+}
+
+bool GpuFigureRenderer::DrawPoints(
+    ImDrawList *     draw_list,
+    const FigureView points,
+    const ImVec2     origin,
+    const float      zoom,
+    const ImU32      color,
+    const float      thickness
+  )
+{
+  if (!CanDraw() || points.Size() < 2)
+    return false;
+
+  auto & Stream = m_Streams[(m_Frame + 1) % m_Streams.size()];
+  const VkDeviceSize Size = points.Size() * sizeof(ImVec2);
+
+  if (m_StreamUsed + Size > Stream.Size)
+  {
+    // Commands recorded earlier in this frame still read the old buffer
+    const auto Capacity = std::max({ Size, 2 * Stream.Size, MIN_STREAM_POINTS * sizeof(ImVec2) });
+
+    if (Stream.Buffer)
+      m_Retired.push_back(RetiredBuffer{ Buffer{ Stream, 0 }, m_Frame + 1 });
+
+    Stream = HostBuffer{};
+    m_StreamUsed = 0;
+
+    try
+    {
+      Stream = CreateHostBuffer(m_Info.PhysicalDevice, m_Info.Device, m_Info.Allocator, Capacity, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT);
+    }
+    catch (const std::exception & ex)
+    {
+      std::cerr << "GPU figure renderer: " << ex.what() << std::endl;
+      return false;
+    }
+  }
+
+  auto * Vertices = reinterpret_cast<ImVec2 *>(static_cast<char *>(Stream.Data) + m_StreamUsed);
+
+  for (std::size_t i = 0; i < points.Size(); ++i)
+    Vertices[i] = points[i];
+
+  const auto Offset = m_StreamUsed;
+  m_StreamUsed += Size;
+
+  return AddCommand(draw_list, Stream.Buffer, Offset, std::uint32_t(points.Size()), origin, zoom, color, thickness);
+}
+
+//
+// Service
+//
+
+bool GpuFigureRenderer::AddCommand(
+    ImDrawList *        draw_list,
+    VkBuffer            buffer,
+    const VkDeviceSize  offset,
+    const std::uint32_t count,
+    const ImVec2        origin,
+    const float         zoom,
+    const ImU32         color,
+    const float         thickness
+  )
+{
+  auto & Command = m_Commands.emplace_back();
+  Command.Buffer = buffer;
+  Command.Offset = offset;
+  Command.Count = count;
+  Command.Origin = origin;
+  Command.Zoom = zoom;
+  Command.Color = ImGui::ColorConvertU32ToFloat4(color);
+  Command.Thickness = thickness;
+
+  draw_list->AddCallback(draw_callback, &Command);
+  draw_list->AddCallback(ImDrawCallback_ResetRenderState, nullptr);
+  return true;
+}
+
+void GpuFigureRenderer::CreatePipeline()
+{
+  const auto VertexShader = LoadShaderModule(m_Info.Device, m_Info.Allocator, m_Info.ShaderDirectory + "/figure_curve.vert.spv");
+  const auto FragmentShader = LoadShaderModule(m_Info.Device, m_Info.Allocator, m_Info.ShaderDirectory + "/figure_curve.frag.spv");
+
+  // Reported once here, the draw calls then fall back to the CPU quietly
+  if (!VertexShader || !FragmentShader)
+  {
+    std::cerr << "GPU figure renderer: No "
+              << (VertexShader ? "figure_curve.frag.spv" : FragmentShader ? "figure_curve.vert.spv" : "figure_curve shaders")
+              << ", curves are drawn on the CPU" << std::endl;
+
+    if (VertexShader)
+      vkDestroyShaderModule(m_Info.Device, VertexShader, m_Info.Allocator);
+
+    if (FragmentShader)
+      vkDestroyShaderModule(m_Info.Device, FragmentShader, m_Info.Allocator);
+
+    return;
+  }
+
+  VkPushConstantRange PushConstantRange = {};
+  PushConstantRange.stageFlags = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT;
+  PushConstantRange.size = sizeof(PushConstants);
+
+  VkPipelineLayoutCreateInfo LayoutInfo = {};
+  LayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+  LayoutInfo.pushConstantRangeCount = 1;
+  LayoutInfo.pPushConstantRanges = &PushConstantRange;
+  CheckVulkan(vkCreatePipelineLayout(m_Info.Device, &LayoutInfo, m_Info.Allocator, &m_PipelineLayout), "GPU figure renderer: Failed to create the pipeline layout");
+
+  VkPipelineShaderStageCreateInfo Stages[2] = {};
+  Stages[0].sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+  Stages[0].stage = VK_SHADER_STAGE_VERTEX_BIT;
+  Stages[0].module = VertexShader;
+  Stages[0].pName = "main";
+  Stages[1].sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+  Stages[1].stage = VK_SHADER_STAGE_FRAGMENT_BIT;
+  Stages[1].module = FragmentShader;
+  Stages[1].pName = "main";
+
+  // Every instance (segment) reads four consecutive points of the polyline,
+  // the buffer is bound once per point, see Record()
+  VkVertexInputBindingDescription Bindings[4] = {};
+  VkVertexInputAttributeDescription Attributes[4] = {};
+
+  for (std::uint32_t i = 0; i < 4; ++i)
+  {
+    Bindings[i].binding = i;
+    Bindings[i].stride = sizeof(ImVec2);
+    Bindings[i].inputRate = VK_VERTEX_INPUT_RATE_INSTANCE;
+
+    Attributes[i].location = i;
+    Attributes[i].binding = i;
+    Attributes[i].format = VK_FORMAT_R32G32_SFLOAT;
+  }
+
+  VkPipelineVertexInputStateCreateInfo VertexInput = {};
+  VertexInput.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
+  VertexInput.vertexBindingDescriptionCount = 4;
+  VertexInput.pVertexBindingDescriptions = Bindings;
+  VertexInput.vertexAttributeDescriptionCount = 4;
+  VertexInput.pVertexAttributeDescriptions = Attributes;
+
+  VkPipelineInputAssemblyStateCreateInfo InputAssembly = {};
+  InputAssembly.sType = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO;
+  InputAssembly.topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_STRIP;
+
+  VkPipelineViewportStateCreateInfo ViewportState = {};
+  ViewportState.sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
+  ViewportState.viewportCount = 1;
+  ViewportState.scissorCount = 1;
+
+  VkPipelineRasterizationStateCreateInfo Rasterization = {};
+  Rasterization.sType = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO;
+  Rasterization.polygonMode = VK_POLYGON_MODE_FILL;
+  Rasterization.cullMode = VK_CULL_MODE_NONE;
+  Rasterization.frontFace = VK_FRONT_FACE_COUNTER_CLOCKWISE;
+  Rasterization.lineWidth = 1.0f;
+
+  VkPipelineMultisampleStateCreateInfo Multisample = {};
+  Multisample.sType = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO;
+  Multisample.rasterizationSamples = VK_SAMPLE_COUNT_1_BIT;
+
+  // Same blending as the ImGui pipeline
+  VkPipelineColorBlendAttachmentState BlendAttachment = {};
+  BlendAttachment.blendEnable = VK_TRUE;
+  BlendAttachment.srcColorBlendFactor = VK_BLEND_FACTOR_SRC_ALPHA;
+  BlendAttachment.dstColorBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
+  BlendAttachment.colorBlendOp = VK_BLEND_OP_ADD;
+  BlendAttachment.srcAlphaBlendFactor = VK_BLEND_FACTOR_ONE;
+  BlendAttachment.dstAlphaBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
+  BlendAttachment.alphaBlendOp = VK_BLEND_OP_ADD;
+  BlendAttachment.colorWriteMask = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT | VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT;
+
+  VkPipelineColorBlendStateCreateInfo ColorBlend = {};
+  ColorBlend.sType = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO;
+  ColorBlend.attachmentCount = 1;
+  ColorBlend.pAttachments = &BlendAttachment;
+
+  VkPipelineDepthStencilStateCreateInfo DepthStencil = {};
+  DepthStencil.sType = VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO;
+
+  const VkDynamicState DynamicStates[] = { VK_DYNAMIC_STATE_VIEWPORT, VK_DYNAMIC_STATE_SCISSOR };
+
+  VkPipelineDynamicStateCreateInfo DynamicState = {};
+  DynamicState.sType = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO;
+  DynamicState.dynamicStateCount = std::uint32_t(std::size(DynamicStates));
+  DynamicState.pDynamicStates = DynamicStates;
+
+  VkGraphicsPipelineCreateInfo PipelineInfo = {};
+  PipelineInfo.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
+  PipelineInfo.stageCount = 2;
+  PipelineInfo.pStages = Stages;
+  PipelineInfo.pVertexInputState = &VertexInput;
+  PipelineInfo.pInputAssemblyState = &InputAssembly;
+  PipelineInfo.pViewportState = &ViewportState;
+  PipelineInfo.pRasterizationState = &Rasterization;
+  PipelineInfo.pMultisampleState = &Multisample;
+  PipelineInfo.pDepthStencilState = &DepthStencil;
+  PipelineInfo.pColorBlendState = &ColorBlend;
+  PipelineInfo.pDynamicState = &DynamicState;
+  PipelineInfo.layout = m_PipelineLayout;
+  PipelineInfo.renderPass = m_Info.RenderPass;
+  PipelineInfo.subpass = 0;
+
+  const auto Result = vkCreateGraphicsPipelines(m_Info.Device, m_Info.PipelineCache, 1, &PipelineInfo, m_Info.Allocator, &m_Pipeline);
+
+  vkDestroyShaderModule(m_Info.Device, VertexShader, m_Info.Allocator);
+  vkDestroyShaderModule(m_Info.Device, FragmentShader, m_Info.Allocator);
+
+  CheckVulkan(Result, "GPU figure renderer: Failed to create the curve pipeline");
+
+  m_IsAvailable = true;
+}
+
+void GpuFigureRenderer::Destroy(
+    Buffer & buffer
+  )
+{
+  DestroyHostBuffer(m_Info.Device, m_Info.Allocator, buffer.Vertices);
+}
+
+void GpuFigureRenderer::Retire(
+    const Buffer & buffer
+  )
+{
+  if (buffer.Vertices.Buffer)
+    m_Retired.push_back(RetiredBuffer{ buffer, m_Frame });
+}
+
+void GpuFigureRenderer::Record(
+    const ImDrawList *  parent_list,
+    const ImDrawCmd &   cmd,
+    const DrawCommand & command
+  )
+{
+  if (!m_CommandBuffer || !m_DrawData)
+    return;
+
+  // The window moved to a platform window after it was drawn
+  const ImDrawList * const * Lists = m_DrawData->CmdLists;
+  const auto * ListsEnd = Lists + m_DrawData->CmdListsCount;
+
+  if (std::find(Lists, ListsEnd, parent_list) == ListsEnd)
+    return;
+
+  const auto DisplayPos = m_DrawData->DisplayPos;
+  const auto DisplaySize = m_DrawData->DisplaySize;
+  const auto Scale = m_DrawData->FramebufferScale;
+
+  VkViewport Viewport = {};
+  Viewport.width = DisplaySize.x * Scale.x;
+  Viewport.height = DisplaySize.y * Scale.y;
+  Viewport.maxDepth = 1.0f;
+
+  const auto ClipMin = ImVec2{ std::max(0.f, (cmd.ClipRect.x - DisplayPos.x) * Scale.x), std::max(0.f, (cmd.ClipRect.y - DisplayPos.y) * Scale.y) };
+  const auto ClipMax = ImVec2{ std::min(Viewport.width, (cmd.ClipRect.z - DisplayPos.x) * Scale.x), std::min(Viewport.height, (cmd.ClipRect.w - DisplayPos.y) * Scale.y) };
+
+  if (ClipMax.x <= ClipMin.x || ClipMax.y <= ClipMin.y)
+    return;
+
+  VkRect2D Scissor;
+  Scissor.offset.x = std::int32_t(ClipMin.x);
+  Scissor.offset.y = std::int32_t(ClipMin.y);
+  Scissor.extent.width = std::uint32_t(ClipMax.x - ClipMin.x);
+  Scissor.extent.height = std::uint32_t(ClipMax.y - ClipMin.y);
+
+  // Canvas -> framebuffer pixels, the shaders measure the stroke in pixels
+  PushConstants Constants = {};
+  Constants.Scale[0] = command.Zoom * Scale.x;
+  Constants.Scale[1] = command.Zoom * Scale.y;
+  Constants.Translate[0] = (command.Origin.x - DisplayPos.x) * Scale.x;
+  Constants.Translate[1] = (command.Origin.y - DisplayPos.y) * Scale.y;
+  Constants.Color[0] = command.Color.x;
+  Constants.Color[1] = command.Color.y;
+  Constants.Color[2] = command.Color.z;
+  Constants.Color[3] = command.Color.w;
+  Constants.ViewportSize[0] = Viewport.width;
+  Constants.ViewportSize[1] = Viewport.height;
+  Constants.HalfWidth = command.Thickness * Scale.x * 0.5f;
+
+  vkCmdBindPipeline(m_CommandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, m_Pipeline);
+  vkCmdSetViewport(m_CommandBuffer, 0, 1, &Viewport);
+  vkCmdSetScissor(m_CommandBuffer, 0, 1, &Scissor);
+  vkCmdPushConstants(m_CommandBuffer, m_PipelineLayout, VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT, 0, sizeof(Constants), &Constants);
+
+  // Instance i of a draw reads the points at the four binding offsets plus
+  // i. The first and the last segment have no neighbour on one side, they
+  // are drawn on their own with that binding on their end point, which the
+  // shaders treat as an unshared round cap. All reads stay in the buffer.
+  const auto DrawSegments = [&](const std::uint32_t previous, const std::uint32_t start, const std::uint32_t next, const std::uint32_t count)
+  {
+    const VkBuffer Buffers[4] = { command.Buffer, command.Buffer, command.Buffer, command.Buffer };
+    const VkDeviceSize Offsets[4] =
+    {
+      command.Offset + previous * sizeof(ImVec2),
+      command.Offset + start * sizeof(ImVec2),
+      command.Offset + (start + 1) * sizeof(ImVec2),
+      command.Offset + next * sizeof(ImVec2),
+    };
+
+    vkCmdBindVertexBuffers(m_CommandBuffer, 0, 4, Buffers, Offsets);
+    vkCmdDraw(m_CommandBuffer, 4, count, 0, 0);
+  };
+
+  const auto Last = command.Count - 1;
+
+  DrawSegments(0, 0, std::min(2u, Last), 1);
+
+  if (Last >= 3)
+    DrawSegments(0, 1, 3, Last - 2);
+
+  if (Last >= 2)
+    DrawSegments(Last - 2, Last - 1, Last, 1);
+}
+
+//
+// Static service
+//
+
+void GpuFigureRenderer::draw_callback(
+    const ImDrawList * parent_list,
+    const ImDrawCmd *  cmd
+  )
+{
+  Instance().Record(parent_list, *cmd, *static_cast<const DrawCommand *>(cmd->UserCallbackData));
+}
+
+//
+// GpuFigure
+//
+
+GpuFigure::GpuFigure() :
+  m_Handle(GpuFigureRenderer::Instance().Create())
+{
+  // Empty
+}
+
+GpuFigure::~GpuFigure()
+{
+  GpuFigureRenderer::Instance().Release(m_Handle);
+}
+
+bool GpuFigure::Upload(
+    const FigureView points
+  )
+{
+  return GpuFigureRenderer::Instance().Upload(m_Handle, points);
+}
+
+bool GpuFigure::Draw(
+    const ImVec2 origin,
+    const float  zoom,
+    const ImU32  color,
+    const float  thickness
+  )
+{
+  return GpuFigureRenderer::Instance().Draw(ImGui::GetWindowDrawList(), m_Handle, origin, zoom, color, thickness);
+}
+
+//
+// Drawing
+//
+
+void DrawCurve(
+    const FigureView points,
+    const ImVec2     pos,
+    const ImU32      col,
+    const float      thickness,
+    const float      scale
+  )
+{
+  if (!GpuFigureRenderer::Instance().DrawPoints(ImGui::GetWindowDrawList(), points, pos, scale, col, thickness))
+    DrawPolyline(points, pos, col, thickness, scale);
+}
+
+void DrawCurveFigure(
+    const FigureView points,
+    const ImVec2     pos,
+    const ImU32      col,
+    const float      thickness,
+    const float      scale
+  )
+{
+  if (points.Size() < 2)
+    return;
+
+  DrawCurve(GetSpline(points, SPLINE_POINTS_PER_SEGMENT, FrameArena::GetResource()), pos, col, thickness, scale);
+}
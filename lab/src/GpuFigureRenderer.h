@@ -0,0 +1,288 @@
+#pragma once
+
+#include "FigureView.h"
+#include "VulkanHelpers.h"
+
+#include <imgui.h>
+#include <vulkan/vulkan.h>
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <unordered_map>
+#include <cstdint>
+
+//
+// Draws polylines as instanced segment quads: one 8-byte point per vertex
+// of the polyline, four vertices per segment generated in the vertex
+// shader, and a signed-distance fragment shader that anti-aliases the
+// stroke and rounds its joins at any thickness. A join pixel is drawn only
+// by the closer of its two segments, so translucent strokes stay even.
+// Drawing adds an ImDrawList callback that binds the pipeline and the
+// points, so no thick-line geometry goes through the ImGui vertex buffers.
+//
+// Static figures are uploaded once (and again only when edited), other
+// curves are streamed into a per-frame buffer by DrawPoints().
+//
+// The draw calls return false whenever the GPU path cannot be used (no
+// device, missing shaders, window on a secondary viewport), the caller
+// then draws through the CPU path as before. Missing shaders are reported
+// once by Init().
+//
+
+class GpuFigureRenderer
+{
+public: // Types
+
+  using Handle = std::uint32_t;
+
+  struct InitInfo
+  {
+    VkPhysicalDevice              PhysicalDevice = VK_NULL_HANDLE;
+    VkDevice                      Device         = VK_NULL_HANDLE;
+    VkRenderPass                  RenderPass     = VK_NULL_HANDLE;
+    VkPipelineCache               PipelineCache  = VK_NULL_HANDLE;
+    const VkAllocationCallbacks * Allocator      = nullptr;
+    std::uint32_t                 ImageCount     = 2;
+    std::string                   ShaderDirectory = "shaders";
+  };
+
+public: // Interface
+
+  static GpuFigureRenderer & Instance();
+
+  // Leaves the renderer unavailable (and logs why) when the shaders
+  // can not be loaded
+  void Init(
+      const InitInfo & info
+    );
+
+  // The device must be idle
+  void Shutdown();
+
+  // Follows a swapchain rebuilt with a different number of images, the
+  // device must be idle
+  void SetImageCount(
+      const std::uint32_t image_count
+    );
+
+  bool IsAvailable() const;
+
+  // Called with the command buffer of the main viewport, after its fence
+  // was waited on, before the draw data is recorded
+  void BeginFrame(
+      VkCommandBuffer    command_buffer,
+      const ImDrawData * draw_data
+    );
+
+  void EndFrame();
+
+  // Handles may be created before Init()
+  Handle Create();
+
+  // Replaces the vertices of the figure, the previous buffer is released
+  // once the frames that used it are finished
+  bool Upload(
+      const Handle     handle,
+      const FigureView points
+    );
+
+  void Release(
+      const Handle handle
+    );
+
+  // Whether the draw calls can be used in the current window
+  bool CanDraw() const;
+
+  // Draws the uploaded polyline into the current window at `origin`
+  // scaled by `zoom`
+  bool Draw(
+      ImDrawList *  draw_list,
+      const Handle  handle,
+      const ImVec2  origin,
+      const float   zoom,
+      const ImU32   color,
+      const float   thickness
+    );
+
+  // Same for a vertex buffer owned by the caller (tightly packed ImVec2),
+  // which must stay alive until the frame is finished
+  bool DrawBuffer(
+      ImDrawList *        draw_list,
+      VkBuffer            buffer,
+      const std::uint32_t count,
+      const ImVec2        origin,
+      const float         zoom,
+      const ImU32         color,
+      const float         thickness
+    );
+
+  // Same for points that change every frame, they are copied into the
+  // stream buffer of the frame
+  bool DrawPoints(
+      ImDrawList *     draw_list,
+      const FigureView points,
+      const ImVec2     origin,
+      const float      zoom,
+      const ImU32      color,
+      const float      thickness
+    );
+
+private: // Types
+
+  struct Buffer
+  {
+    HostBuffer    Vertices;
+    std::uint32_t Count = 0;
+  };
+
+  struct RetiredBuffer
+  {
+    Buffer        Resource;
+    std::uint64_t Frame = 0;
+  };
+
+  struct DrawCommand
+  {
+    VkBuffer      Buffer = VK_NULL_HANDLE;
+    VkDeviceSize  Offset = 0;
+    std::uint32_t Count = 0;
+    ImVec2        Origin;
+    float         Zoom = 1;
+    ImVec4        Color;
+    float         Thickness = 1;
+  };
+
+  // Matches the push constant block of the figure_curve shaders
+  struct PushConstants
+  {
+    float Scale[2];
+    float Translate[2];
+    float Color[4];
+    float ViewportSize[2];
+    float HalfWidth;
+    float Padding;
+  };
+
+private: // Service
+
+  GpuFigureRenderer() = default;
+
+  void CreatePipeline();
+
+  void Destroy(
+      Buffer & buffer
+    );
+
+  void Retire(
+      const Buffer & buffer
+    );
+
+  bool AddCommand(
+      ImDrawList *        draw_list,
+      VkBuffer            buffer,
+      const VkDeviceSize  offset,
+      const std::uint32_t count,
+      const ImVec2        origin,
+      const float         zoom,
+      const ImU32         color,
+      const float         thickness
+    );
+
+  void Record(
+      const ImDrawList *  parent_list,
+      const ImDrawCmd &   cmd,
+      const DrawCommand & command
+    );
+
+private: // Static service
+
+  static void draw_callback(
+      const ImDrawList * parent_list,
+      const ImDrawCmd *  cmd
+    );
+
+private: // Constants
+
+  // Points the stream buffer of a frame starts with, it doubles on demand
+  static constexpr VkDeviceSize MIN_STREAM_POINTS = 64 * 1024;
+
+private: // Members
+
+  InitInfo                           m_Info;
+  bool                               m_IsAvailable = false;
+  VkPipelineLayout                   m_PipelineLayout = VK_NULL_HANDLE;
+  VkPipeline                         m_Pipeline = VK_NULL_HANDLE;
+
+  std::unordered_map<Handle, Buffer> m_Buffers;
+  Handle                             m_NextHandle = 1;
+  std::deque<RetiredBuffer>          m_Retired;
+  std::uint64_t                      m_Frame = 0;
+
+  // One stream buffer per frame that may be in flight, the points drawn
+  // during the UI pass of frame m_Frame + 1 go into one of them
+  std::vector<HostBuffer>            m_Streams;
+  VkDeviceSize                       m_StreamUsed = 0;
+
+  // Valid between BeginFrame() and EndFrame(), deque keeps the addresses
+  // handed to the draw list callbacks stable
+  VkCommandBuffer                    m_CommandBuffer = VK_NULL_HANDLE;
+  const ImDrawData *                 m_DrawData = nullptr;
+  std::deque<DrawCommand>            m_Commands;
+};
+
+//
+// Owns a renderer handle for the lifetime of a window
+//
+
+class GpuFigure
+{
+public: // Construction / Destruction
+
+  GpuFigure();
+
+  ~GpuFigure();
+
+  GpuFigure(const GpuFigure &) = delete;
+  GpuFigure & operator=(const GpuFigure &) = delete;
+
+public: // Interface
+
+  bool Upload(
+      const FigureView points
+    );
+
+  bool Draw(
+      const ImVec2 origin,
+      const float  zoom,
+      const ImU32  color,
+      const float  thickness
+    );
+
+private: // Members
+
+  GpuFigureRenderer::Handle m_Handle;
+};
+
+//
+// Drawing
+//
+
+// Draws the polyline through the renderer when it can be used in the
+// current window, with DrawPolyline() otherwise
+void DrawCurve(
+    const FigureView points,
+    const ImVec2     pos,
+    const ImU32      col = 0xFFFFFFFF,
+    const float      thickness = 1,
+    const float      scale = 1
+  );
+
+// Same for the spline through the points, see DrawFigure()
+void DrawCurveFigure(
+    const FigureView points,
+    const ImVec2     pos,
+    const ImU32      col = 0xFFFFFFFF,
+    const float      thickness = 1,
+    const float      scale = 1
+  );
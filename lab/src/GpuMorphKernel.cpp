@@ -0,0 +1,543 @@
+#include "GpuMorphKernel.h"
+#include "GpuFigureRenderer.h"
+#include "ImVecUtils.h"
+
+#include <algorithm>
+#include <iostream>
+#include <cstring>
+#include <cmath>
+
+namespace
+{
+
+// Maps the bits of a float to an integer that grows with the value, so the
+// difference of two of them is their distance in units in the last place
+std::int64_t OrderedBits(
+    const float value
+  )
+{
+  std::int32_t Bits;
+  std::memcpy(&Bits, &value, sizeof(Bits));
+  return Bits < 0 ? std::int64_t(INT32_MIN) - Bits : Bits;
+}
+
+} // namespace
+
+KernelComparison CompareOutlines(
+    const FigureView gpu,
+    const FigureView cpu
+  )
+{
+  KernelComparison Result;
+  Result.Count = std::max(gpu.Size(), cpu.Size());
+
+  if (gpu.Size() != cpu.Size())
+  {
+    Result.MaxUlps = UINT32_MAX;
+    Result.MaxError = INFINITY;
+    return Result;
+  }
+
+  for (std::size_t i = 0; i < gpu.Size(); ++i)
+  {
+    const auto Gpu = gpu[i];
+    const auto Cpu = cpu[i];
+
+    if (std::memcmp(&Gpu, &Cpu, sizeof(ImVec2)) == 0)
+    {
+      ++Result.Identical;
+      continue;
+    }
+
+    for (const auto [a, b] : { std::pair{ Gpu.x, Cpu.x }, std::pair{ Gpu.y, Cpu.y } })
+    {
+      const auto Ulps = std::min<std::uint64_t>(std::abs(OrderedBits(a) - OrderedBits(b)), UINT32_MAX);
+      Result.MaxUlps = std::max(Result.MaxUlps, std::uint32_t(Ulps));
+      Result.MaxError = std::max(Result.MaxError, std::abs(a - b));
+    }
+  }
+
+  return Result;
+}
+
+//
+// Interface
+//
+
+GpuMorphKernel & GpuMorphKernel::Instance()
+{
+  static GpuMorphKernel Kernel;
+  return Kernel;
+}
+
+void GpuMorphKernel::Init(
+    const InitInfo & info
+  )
+{
+  m_Info = info;
+
+  CreatePipeline();
+
+  if (!m_IsAvailable)
+    return;
+
+  // The same accumulated parameters TessellateSplineSegment walks through
+  std::vector<float> Samples;
+  const float Delta = 1.0f / (SPLINE_POINTS_PER_SEGMENT + 1);
+
+  for (float t = 0; t <= 1.0f; t += Delta)
+    Samples.push_back(t);
+
+  m_SampleCount = std::uint32_t(Samples.size());
+  m_Samples = CreateHostBuffer(m_Info.PhysicalDevice, m_Info.Device, m_Info.Allocator, Samples.size() * sizeof(float), VK_BUFFER_USAGE_STORAGE_BUFFER_BIT);
+  std::memcpy(m_Samples.Data, Samples.data(), Samples.size() * sizeof(float));
+}
+
+void GpuMorphKernel::Shutdown()
+{
+  for (auto & [Handle, Resources] : m_Morphs)
+    Destroy(Resources);
+
+  for (auto & Retired : m_Retired)
+    Destroy(Retired.Resources);
+
+  m_Morphs.clear();
+  m_Retired.clear();
+  m_Pending.clear();
+
+  DestroyHostBuffer(m_Info.Device, m_Info.Allocator, m_Samples);
+
+  if (m_Fence)
+    vkDestroyFence(m_Info.Device, m_Fence, m_Info.Allocator);
+
+  if (m_CommandPool)
+    vkDestroyCommandPool(m_Info.Device, m_CommandPool, m_Info.Allocator);
+
+  if (m_DescriptorPool)
+    vkDestroyDescriptorPool(m_Info.Device, m_DescriptorPool, m_Info.Allocator);
+
+  if (m_Pipeline)
+    vkDestroyPipeline(m_Info.Device, m_Pipeline, m_Info.Allocator);
+
+  if (m_PipelineLayout)
+    vkDestroyPipelineLayout(m_Info.Device, m_PipelineLayout, m_Info.Allocator);
+
+  if (m_SetLayout)
+    vkDestroyDescriptorSetLayout(m_Info.Device, m_SetLayout, m_Info.Allocator);
+
+  m_Fence = VK_NULL_HANDLE;
+  m_CommandBuffer = VK_NULL_HANDLE;
+  m_CommandPool = VK_NULL_HANDLE;
+  m_DescriptorPool = VK_NULL_HANDLE;
+  m_Pipeline = VK_NULL_HANDLE;
+  m_PipelineLayout = VK_NULL_HANDLE;
+  m_SetLayout = VK_NULL_HANDLE;
+  m_IsAvailable = false;
+}
+
+void GpuMorphKernel::SetImageCount(
+    const std::uint32_t image_count
+  )
+{
+  m_Info.ImageCount = image_count;
+}
+
+bool GpuMorphKernel::IsAvailable() const
+{
+  return m_IsAvailable;
+}
+
+void GpuMorphKernel::BeginFrame(
+    VkCommandBuffer command_buffer
+  )
+{
+  ++m_Frame;
+
+  // A retired morph may still be used by any frame in flight
+  while (!m_Retired.empty() && m_Retired.front().Frame + m_Info.ImageCount + 1 < m_Frame)
+  {
+    Destroy(m_Retired.front().Resources);
+    m_Retired.pop_front();
+  }
+
+  if (m_Pending.empty())
+    return;
+
+  // Earlier frames may still be drawing the outlines about to be rewritten
+  vkCmdPipelineBarrier(command_buffer, VK_PIPELINE_STAGE_VERTEX_INPUT_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 0, nullptr, 0, nullptr, 0, nullptr);
+
+  for (const auto & Dispatch : m_Pending)
+    RecordDispatch(command_buffer, Dispatch.Set, Dispatch.PointCount, Dispatch.Weight);
+
+  VkMemoryBarrier Barrier = {};
+  Barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+  Barrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+  Barrier.dstAccessMask = VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT;
+  vkCmdPipelineBarrier(command_buffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_VERTEX_INPUT_BIT, 0, 1, &Barrier, 0, nullptr, 0, nullptr);
+}
+
+void GpuMorphKernel::EndFrame()
+{
+  m_Pending.clear();
+}
+
+GpuMorphKernel::Handle GpuMorphKernel::Create()
+{
+  const auto Result = m_NextHandle++;
+  m_Morphs.emplace(Result, Morph{});
+  return Result;
+}
+
+void GpuMorphKernel::Release(
+    const Handle handle
+  )
+{
+  const auto Found = m_Morphs.find(handle);
+
+  if (Found == m_Morphs.end())
+    return;
+
+  Retire(Found->second);
+  m_Morphs.erase(Found);
+}
+
+bool GpuMorphKernel::Upload(
+    const Handle     handle,
+    const FigureView first,
+    const FigureView second
+  )
+{
+  const auto Found = m_Morphs.find(handle);
+
+  if (Found == m_Morphs.end())
+    return false;
+
+  Retire(Found->second);
+  Found->second = Morph{};
+
+  if (!m_IsAvailable || first.Size() != second.Size() || first.Size() < 3)
+    return false;
+
+  const auto Count = first.Size();
+  const auto OutlineCount = (Count - 1) * m_SampleCount;
+
+  Morph Result;
+  Result.PointCount = std::uint32_t(Count);
+  Result.OutlineCount = std::uint32_t(OutlineCount);
+
+  try
+  {
+    Result.First = CreateHostBuffer(m_Info.PhysicalDevice, m_Info.Device, m_Info.Allocator, Count * sizeof(ImVec2), VK_BUFFER_USAGE_STORAGE_BUFFER_BIT);
+    Result.Second = CreateHostBuffer(m_Info.PhysicalDevice, m_Info.Device, m_Info.Allocator, Count * sizeof(ImVec2), VK_BUFFER_USAGE_STORAGE_BUFFER_BIT);
+    Result.Outline = CreateHostBuffer(m_Info.PhysicalDevice, m_Info.Device, m_Info.Allocator, OutlineCount * sizeof(ImVec2), VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT);
+    Result.Set = AllocateSet(Result, Result.Outline);
+  }
+  catch (const std::exception & ex)
+  {
+    // Out of memory for a huge figure, it is morphed on the CPU
+    std::cerr << "GPU morph kernel: " << ex.what() << std::endl;
+    Destroy(Result);
+    return false;
+  }
+
+  auto * First = static_cast<ImVec2 *>(Result.First.Data);
+  auto * Second = static_cast<ImVec2 *>(Result.Second.Data);
+
+  for (std::size_t i = 0; i < Count; ++i)
+  {
+    First[i] = first[i];
+    Second[i] = second[i];
+  }
+
+  Found->second = Result;
+  return true;
+}
+
+bool GpuMorphKernel::Dispatch(
+    const Handle handle,
+    const float  weight
+  )
+{
+  const auto Found = m_Morphs.find(handle);
+
+  if (!m_IsAvailable || Found == m_Morphs.end() || !Found->second.Set)
+    return false;
+
+  m_Pending.push_back(PendingDispatch{ Found->second.Set, Found->second.PointCount, weight });
+  return true;
+}
+
+VkBuffer GpuMorphKernel::GetOutline(
+    const Handle    handle,
+    std::uint32_t & count
+  ) const
+{
+  const auto Found = m_Morphs.find(handle);
+
+  if (Found == m_Morphs.end())
+  {
+    count = 0;
+    return VK_NULL_HANDLE;
+  }
+
+  count = Found->second.OutlineCount;
+  return Found->second.Outline.Buffer;
+}
+
+std::vector<ImVec2> GpuMorphKernel::ReadBack(
+    const Handle handle,
+    const float  weight
+  )
+{
+  const auto Found = m_Morphs.find(handle);
+
+  if (!m_IsAvailable || Found == m_Morphs.end() || !Found->second.Set)
+    return {};
+
+  const auto & Resources = Found->second;
+
+  // A separate outline, the frame one may be in use by the GPU
+  auto Outline = CreateHostBuffer(m_Info.PhysicalDevice, m_Info.Device, m_Info.Allocator, Resources.OutlineCount * sizeof(ImVec2), VK_BUFFER_USAGE_STORAGE_BUFFER_BIT);
+  const auto Set = AllocateSet(Resources, Outline);
+
+  CheckVulkan(vkResetCommandPool(m_Info.Device, m_CommandPool, 0), "GPU morph kernel: Failed to reset the command pool");
+
+  VkCommandBufferBeginInfo BeginInfo = {};
+  BeginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+  BeginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+  CheckVulkan(vkBeginCommandBuffer(m_CommandBuffer, &BeginInfo), "GPU morph kernel: Failed to begin the command buffer");
+
+  RecordDispatch(m_CommandBuffer, Set, Resources.PointCount, weight);
+
+  VkMemoryBarrier Barrier = {};
+  Barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+  Barrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+  Barrier.dstAccessMask = VK_ACCESS_HOST_READ_BIT;
+  vkCmdPipelineBarrier(m_CommandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_HOST_BIT, 0, 1, &Barrier, 0, nullptr, 0, nullptr);
+
+  CheckVulkan(vkEndCommandBuffer(m_CommandBuffer), "GPU morph kernel: Failed to end the command buffer");
+
+  VkSubmitInfo SubmitInfo = {};
+  SubmitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+  SubmitInfo.commandBufferCount = 1;
+  SubmitInfo.pCommandBuffers = &m_CommandBuffer;
+  CheckVulkan(vkResetFences(m_Info.Device, 1, &m_Fence), "GPU morph kernel: Failed to reset the fence");
+  CheckVulkan(vkQueueSubmit(m_Info.Queue, 1, &SubmitInfo, m_Fence), "GPU morph kernel: Failed to submit");
+  CheckVulkan(vkWaitForFences(m_Info.Device, 1, &m_Fence, VK_TRUE, UINT64_MAX), "GPU morph kernel: Failed to wait for the fence");
+
+  const auto * Data = static_cast<const ImVec2 *>(Outline.Data);
+  std::vector<ImVec2> Result(Data, Data + Resources.OutlineCount);
+
+  vkFreeDescriptorSets(m_Info.Device, m_DescriptorPool, 1, &Set);
+  DestroyHostBuffer(m_Info.Device, m_Info.Allocator, Outline);
+
+  return Result;
+}
+
+//
+// Service
+//
+
+void GpuMorphKernel::CreatePipeline()
+{
+  const auto Shader = LoadShaderModule(m_Info.Device, m_Info.Allocator, m_Info.ShaderDirectory + "/morph_spline.comp.spv");
+
+  if (!Shader)
+  {
+    std::cerr << "GPU morph kernel: No shader, figures are morphed on the CPU" << std::endl;
+    return;
+  }
+
+  VkDescriptorSetLayoutBinding Bindings[4] = {};
+
+  for (std::uint32_t i = 0; i < 4; ++i)
+  {
+    Bindings[i].binding = i;
+    Bindings[i].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+    Bindings[i].descriptorCount = 1;
+    Bindings[i].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+  }
+
+  VkDescriptorSetLayoutCreateInfo SetLayoutInfo = {};
+  SetLayoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+  SetLayoutInfo.bindingCount = 4;
+  SetLayoutInfo.pBindings = Bindings;
+  CheckVulkan(vkCreateDescriptorSetLayout(m_Info.Device, &SetLayoutInfo, m_Info.Allocator, &m_SetLayout), "GPU morph kernel: Failed to create the descriptor set layout");
+
+  VkPushConstantRange PushConstantRange = {};
+  PushConstantRange.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+  PushConstantRange.size = sizeof(PushConstants);
+
+  VkPipelineLayoutCreateInfo LayoutInfo = {};
+  LayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+  LayoutInfo.setLayoutCount = 1;
+  LayoutInfo.pSetLayouts = &m_SetLayout;
+  LayoutInfo.pushConstantRangeCount = 1;
+  LayoutInfo.pPushConstantRanges = &PushConstantRange;
+  CheckVulkan(vkCreatePipelineLayout(m_Info.Device, &LayoutInfo, m_Info.Allocator, &m_PipelineLayout), "GPU morph kernel: Failed to create the pipeline layout");
+
+  VkComputePipelineCreateInfo PipelineInfo = {};
+  PipelineInfo.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+  PipelineInfo.stage.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+  PipelineInfo.stage.stage = VK_SHADER_STAGE_COMPUTE_BIT;
+  PipelineInfo.stage.module = Shader;
+  PipelineInfo.stage.pName = "main";
+  PipelineInfo.layout = m_PipelineLayout;
+
+  const auto Result = vkCreateComputePipelines(m_Info.Device, m_Info.PipelineCache, 1, &PipelineInfo, m_Info.Allocator, &m_Pipeline);
+  vkDestroyShaderModule(m_Info.Device, Shader, m_Info.Allocator);
+  CheckVulkan(Result, "GPU morph kernel: Failed to create the compute pipeline");
+
+  const VkDescriptorPoolSize PoolSize = { VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 4 * MAX_SETS };
+
+  VkDescriptorPoolCreateInfo PoolInfo = {};
+  PoolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+  PoolInfo.flags = VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT;
+  PoolInfo.maxSets = MAX_SETS;
+  PoolInfo.poolSizeCount = 1;
+  PoolInfo.pPoolSizes = &PoolSize;
+  CheckVulkan(vkCreateDescriptorPool(m_Info.Device, &PoolInfo, m_Info.Allocator, &m_DescriptorPool), "GPU morph kernel: Failed to create the descriptor pool");
+
+  VkCommandPoolCreateInfo CommandPoolInfo = {};
+  CommandPoolInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+  CommandPoolInfo.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+  CommandPoolInfo.queueFamilyIndex = m_Info.QueueFamily;
+  CheckVulkan(vkCreateCommandPool(m_Info.Device, &CommandPoolInfo, m_Info.Allocator, &m_CommandPool), "GPU morph kernel: Failed to create the command pool");
+
+  VkCommandBufferAllocateInfo CommandBufferInfo = {};
+  CommandBufferInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+  CommandBufferInfo.commandPool = m_CommandPool;
+  CommandBufferInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+  CommandBufferInfo.commandBufferCount = 1;
+  CheckVulkan(vkAllocateCommandBuffers(m_Info.Device, &CommandBufferInfo, &m_CommandBuffer), "GPU morph kernel: Failed to allocate the command buffer");
+
+  VkFenceCreateInfo FenceInfo = {};
+  FenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+  CheckVulkan(vkCreateFence(m_Info.Device, &FenceInfo, m_Info.Allocator, &m_Fence), "GPU morph kernel: Failed to create the fence");
+
+  m_IsAvailable = true;
+}
+
+VkDescriptorSet GpuMorphKernel::AllocateSet(
+    const Morph &      morph,
+    const HostBuffer & outline
+  )
+{
+  VkDescriptorSetAllocateInfo AllocateInfo = {};
+  AllocateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+  AllocateInfo.descriptorPool = m_DescriptorPool;
+  AllocateInfo.descriptorSetCount = 1;
+  AllocateInfo.pSetLayouts = &m_SetLayout;
+
+  VkDescriptorSet Result = VK_NULL_HANDLE;
+  CheckVulkan(vkAllocateDescriptorSets(m_Info.Device, &AllocateInfo, &Result), "GPU morph kernel: Failed to allocate a descriptor set");
+
+  const VkDescriptorBufferInfo Buffers[4] = {
+      { morph.First.Buffer,  0, VK_WHOLE_SIZE },
+      { morph.Second.Buffer, 0, VK_WHOLE_SIZE },
+      { m_Samples.Buffer,    0, VK_WHOLE_SIZE },
+      { outline.Buffer,      0, VK_WHOLE_SIZE },
+    };
+
+  VkWriteDescriptorSet Writes[4] = {};
+
+  for (std::uint32_t i = 0; i < 4; ++i)
+  {
+    Writes[i].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+    Writes[i].dstSet = Result;
+    Writes[i].dstBinding = i;
+    Writes[i].descriptorCount = 1;
+    Writes[i].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+    Writes[i].pBufferInfo = &Buffers[i];
+  }
+
+  vkUpdateDescriptorSets(m_Info.Device, 4, Writes, 0, nullptr);
+  return Result;
+}
+
+void GpuMorphKernel::RecordDispatch(
+    VkCommandBuffer       command_buffer,
+    VkDescriptorSet       set,
+    const std::uint32_t   point_count,
+    const float           weight
+  )
+{
+  const PushConstants Constants = { point_count, m_SampleCount, weight };
+  const auto Segments = point_count - 1;
+
+  vkCmdBindPipeline(command_buffer, VK_PIPELINE_BIND_POINT_COMPUTE, m_Pipeline);
+  vkCmdBindDescriptorSets(command_buffer, VK_PIPELINE_BIND_POINT_COMPUTE, m_PipelineLayout, 0, 1, &set, 0, nullptr);
+  vkCmdPushConstants(command_buffer, m_PipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(Constants), &Constants);
+  vkCmdDispatch(command_buffer, (Segments + WORKGROUP_SIZE - 1) / WORKGROUP_SIZE, 1, 1);
+}
+
+void GpuMorphKernel::Destroy(
+    Morph & morph
+  )
+{
+  if (morph.Set)
+    vkFreeDescriptorSets(m_Info.Device, m_DescriptorPool, 1, &morph.Set);
+
+  DestroyHostBuffer(m_Info.Device, m_Info.Allocator, morph.First);
+  DestroyHostBuffer(m_Info.Device, m_Info.Allocator, morph.Second);
+  DestroyHostBuffer(m_Info.Device, m_Info.Allocator, morph.Outline);
+  morph = Morph{};
+}
+
+void GpuMorphKernel::Retire(
+    const Morph & morph
+  )
+{
+  if (morph.First.Buffer || morph.Second.Buffer || morph.Outline.Buffer)
+    m_Retired.push_back(RetiredMorph{ morph, m_Frame });
+}
+
+//
+// GpuMorph
+//
+
+GpuMorph::GpuMorph() :
+  m_Handle(GpuMorphKernel::Instance().Create())
+{
+  // Empty
+}
+
+GpuMorph::~GpuMorph()
+{
+  GpuMorphKernel::Instance().Release(m_Handle);
+}
+
+bool GpuMorph::Upload(
+    const FigureView first,
+    const FigureView second
+  )
+{
+  return GpuMorphKernel::Instance().Upload(m_Handle, first, second);
+}
+
+bool GpuMorph::Draw(
+    const float  weight,
+    const ImVec2 origin,
+    const float  zoom,
+    const ImU32  color,
+    const float  thickness
+  )
+{
+  auto & Kernel = GpuMorphKernel::Instance();
+  auto & Renderer = GpuFigureRenderer::Instance();
+
+  std::uint32_t Count = 0;
+  const auto Outline = Kernel.GetOutline(m_Handle, Count);
+
+  if (!Outline || !Renderer.CanDraw() || !Kernel.Dispatch(m_Handle, weight))
+    return false;
+
+  return Renderer.DrawBuffer(ImGui::GetWindowDrawList(), Outline, Count, origin, zoom, color, thickness);
+}
+
+std::vector<ImVec2> GpuMorph::ReadBack(
+    const float weight
+  )
+{
+  return GpuMorphKernel::Instance().ReadBack(m_Handle, weight);
+}
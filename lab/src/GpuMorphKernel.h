@@ -0,0 +1,247 @@
+#pragma once
+
+#include "FigureView.h"
+#include "VulkanHelpers.h"
+
+#include <imgui.h>
+#include <vulkan/vulkan.h>
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <unordered_map>
+#include <cstdint>
+
+//
+// Compute shader version of the per-point morph and its spline
+// tessellation (Morph + GetSpline with LinearInterpolate at an eased
+// weight). The matched figures live in storage buffers uploaded once per
+// edit; every frame a dispatch, recorded before the render pass, writes the
+// tessellated outline straight into a vertex buffer that GpuFigureRenderer
+// draws, so the points never travel back to the CPU.
+//
+// ReadBack() runs the kernel synchronously and returns the outline, it is
+// meant for comparing the GPU against the CPU kernels bit by bit.
+//
+
+// Bitwise agreement of two outlines
+struct KernelComparison
+{
+  std::size_t   Count     = 0; // Compared points
+  std::size_t   Identical = 0; // Points whose coordinates match bit for bit
+  std::uint32_t MaxUlps   = 0; // Largest distance of a coordinate in units in the last place
+  float         MaxError  = 0; // Largest absolute coordinate difference
+};
+
+KernelComparison CompareOutlines(
+    const FigureView gpu,
+    const FigureView cpu
+  );
+
+class GpuMorphKernel
+{
+public: // Types
+
+  using Handle = std::uint32_t;
+
+  struct InitInfo
+  {
+    VkPhysicalDevice              PhysicalDevice = VK_NULL_HANDLE;
+    VkDevice                      Device         = VK_NULL_HANDLE;
+    VkQueue                       Queue          = VK_NULL_HANDLE;
+    std::uint32_t                 QueueFamily    = 0;
+    VkPipelineCache               PipelineCache  = VK_NULL_HANDLE;
+    const VkAllocationCallbacks * Allocator      = nullptr;
+    std::uint32_t                 ImageCount     = 2;
+    std::string                   ShaderDirectory = "shaders";
+  };
+
+public: // Interface
+
+  static GpuMorphKernel & Instance();
+
+  // Leaves the kernel unavailable (and logs why) when the shader can not
+  // be loaded
+  void Init(
+      const InitInfo & info
+    );
+
+  // The device must be idle
+  void Shutdown();
+
+  // Follows a swapchain rebuilt with a different number of images
+  void SetImageCount(
+      const std::uint32_t image_count
+    );
+
+  bool IsAvailable() const;
+
+  // Records the dispatches queued this frame into the command buffer of
+  // the main viewport, outside of the render pass
+  void BeginFrame(
+      VkCommandBuffer command_buffer
+    );
+
+  void EndFrame();
+
+  // Handles may be created before Init()
+  Handle Create();
+
+  void Release(
+      const Handle handle
+    );
+
+  // Figures of equal size, at least 3 points
+  bool Upload(
+      const Handle     handle,
+      const FigureView first,
+      const FigureView second
+    );
+
+  // Queues the morph at `weight` for the current frame
+  bool Dispatch(
+      const Handle handle,
+      const float  weight
+    );
+
+  // Vertex buffer the dispatches of the handle write, VK_NULL_HANDLE
+  // before the first upload
+  VkBuffer GetOutline(
+      const Handle    handle,
+      std::uint32_t & count
+    ) const;
+
+  // Runs the kernel at once, independently of the frame, and returns the
+  // outline it produced
+  std::vector<ImVec2> ReadBack(
+      const Handle handle,
+      const float  weight
+    );
+
+private: // Types
+
+  struct Morph
+  {
+    HostBuffer      First;
+    HostBuffer      Second;
+    HostBuffer      Outline;
+    VkDescriptorSet Set = VK_NULL_HANDLE;
+    std::uint32_t   PointCount = 0;
+    std::uint32_t   OutlineCount = 0;
+  };
+
+  struct RetiredMorph
+  {
+    Morph         Resources;
+    std::uint64_t Frame = 0;
+  };
+
+  struct PendingDispatch
+  {
+    VkDescriptorSet Set = VK_NULL_HANDLE;
+    std::uint32_t   PointCount = 0;
+    float           Weight = 0;
+  };
+
+  // Matches the push constant block of morph_spline.comp
+  struct PushConstants
+  {
+    std::uint32_t Count;
+    std::uint32_t SampleCount;
+    float         Weight;
+  };
+
+private: // Service
+
+  GpuMorphKernel() = default;
+
+  void CreatePipeline();
+
+  VkDescriptorSet AllocateSet(
+      const Morph &      morph,
+      const HostBuffer & outline
+    );
+
+  void RecordDispatch(
+      VkCommandBuffer       command_buffer,
+      VkDescriptorSet       set,
+      const std::uint32_t   point_count,
+      const float           weight
+    );
+
+  void Destroy(
+      Morph & morph
+    );
+
+  void Retire(
+      const Morph & morph
+    );
+
+private: // Constants
+
+  static constexpr std::uint32_t WORKGROUP_SIZE = 64; // local_size_x of the shader
+  static constexpr std::uint32_t MAX_SETS       = 256;
+
+private: // Members
+
+  InitInfo                          m_Info;
+  bool                              m_IsAvailable = false;
+  VkDescriptorSetLayout             m_SetLayout = VK_NULL_HANDLE;
+  VkPipelineLayout                  m_PipelineLayout = VK_NULL_HANDLE;
+  VkPipeline                        m_Pipeline = VK_NULL_HANDLE;
+  VkDescriptorPool                  m_DescriptorPool = VK_NULL_HANDLE;
+  VkCommandPool                     m_CommandPool = VK_NULL_HANDLE;
+  VkCommandBuffer                   m_CommandBuffer = VK_NULL_HANDLE;
+  VkFence                           m_Fence = VK_NULL_HANDLE;
+
+  // Sample parameters of one spline segment, shared by every figure
+  HostBuffer                        m_Samples;
+  std::uint32_t                     m_SampleCount = 0;
+
+  std::unordered_map<Handle, Morph> m_Morphs;
+  Handle                            m_NextHandle = 1;
+  std::deque<RetiredMorph>          m_Retired;
+  std::uint64_t                     m_Frame = 0;
+  std::vector<PendingDispatch>      m_Pending;
+};
+
+//
+// Owns a kernel handle for the lifetime of a window
+//
+
+class GpuMorph
+{
+public: // Construction / Destruction
+
+  GpuMorph();
+
+  ~GpuMorph();
+
+  GpuMorph(const GpuMorph &) = delete;
+  GpuMorph & operator=(const GpuMorph &) = delete;
+
+public: // Interface
+
+  bool Upload(
+      const FigureView first,
+      const FigureView second
+    );
+
+  // Dispatches the morph at `weight` and draws its outline in the
+  // current window
+  bool Draw(
+      const float  weight,
+      const ImVec2 origin,
+      const float  zoom,
+      const ImU32  color,
+      const float  thickness
+    );
+
+  std::vector<ImVec2> ReadBack(
+      const float weight
+    );
+
+private: // Members
+
+  GpuMorphKernel::Handle m_Handle;
+};
@@ -0,0 +1,139 @@
+#include "HandleGrid.h"
+#include "ImVecUtils.h"
+
+#include <algorithm>
+#include <cmath>
+
+//
+// Construction
+//
+
+HandleGrid::HandleGrid(
+    const float cell_size
+  ) :
+    m_CellSize(cell_size)
+{
+  // Empty
+}
+
+//
+// Interface
+//
+
+void HandleGrid::Build(
+    const FigureView points
+  )
+{
+  m_Cells.clear();
+
+  for (std::size_t i = 0; i < points.Size(); ++i)
+    Insert(i, points[i]);
+}
+
+void HandleGrid::Insert(
+    const std::size_t index,
+    const ImVec2      point
+  )
+{
+  m_Cells[GetKey(point)].push_back(std::uint32_t(index));
+}
+
+void HandleGrid::Move(
+    const std::size_t index,
+    const ImVec2      from,
+    const ImVec2      to
+  )
+{
+  const auto From = GetKey(from);
+  const auto To = GetKey(to);
+
+  if (From == To)
+    return;
+
+  if (const auto Found = m_Cells.find(From); Found != m_Cells.end())
+  {
+    auto & Indices = Found->second;
+    const auto Removed = std::find(Indices.begin(), Indices.end(), std::uint32_t(index));
+
+    if (Removed != Indices.end())
+    {
+      *Removed = Indices.back();
+      Indices.pop_back();
+    }
+
+    // Kept when empty, a dragged point tends to come back
+  }
+
+  m_Cells[To].push_back(std::uint32_t(index));
+}
+
+std::optional<std::size_t> HandleGrid::FindNearest(
+    const FigureView points,
+    const ImVec2     position,
+    const float      radius
+  ) const
+{
+  std::optional<std::size_t> Result;
+  float BestDistance = radius;
+
+  const auto Visit = [&](const std::vector<std::uint32_t> & indices)
+  {
+    for (const auto i : indices)
+    {
+      const auto Distance = ImVecDistance(points[i], position);
+
+      if (Distance < BestDistance || (Distance == BestDistance && Result && i < *Result))
+      {
+        BestDistance = Distance;
+        Result = i;
+      }
+    }
+  };
+
+  const auto MinX = ToCell(position.x - radius);
+  const auto MaxX = ToCell(position.x + radius);
+  const auto MinY = ToCell(position.y - radius);
+  const auto MaxY = ToCell(position.y + radius);
+
+  // Zoomed far out the radius spans more cells than there are occupied
+  if (double(MaxX - MinX + 1) * (MaxY - MinY + 1) > double(m_Cells.size()))
+  {
+    for (const auto & [Key, Indices] : m_Cells)
+      Visit(Indices);
+
+    return Result;
+  }
+
+  for (auto y = MinY; y <= MaxY; ++y)
+    for (auto x = MinX; x <= MaxX; ++x)
+      if (const auto Found = m_Cells.find(GetKey(x, y)); Found != m_Cells.end())
+        Visit(Found->second);
+
+  return Result;
+}
+
+//
+// Service
+//
+
+std::int32_t HandleGrid::ToCell(
+    const float coordinate
+  ) const
+{
+  return std::int32_t(std::floor(coordinate / m_CellSize));
+}
+
+HandleGrid::Key HandleGrid::GetKey(
+    const std::int32_t x,
+    const std::int32_t y
+  )
+{
+  return (Key(std::uint32_t(x)) << 32) | std::uint32_t(y);
+}
+
+HandleGrid::Key HandleGrid::GetKey(
+    const ImVec2 point
+  ) const
+{
+  return GetKey(ToCell(point.x), ToCell(point.y));
+}
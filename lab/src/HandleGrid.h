@@ -0,0 +1,79 @@
+#pragma once
+
+#include "FigureView.h"
+
+#include <imgui.h>
+#include <unordered_map>
+#include <vector>
+#include <optional>
+#include <cstdint>
+#include <cstddef>
+
+//
+// Uniform grid over the points of a figure for hit tests. A cell lists the
+// indices of the points inside it, the coordinates stay in the figure, so
+// moving a point only touches the cells it leaves and enters.
+//
+
+class HandleGrid
+{
+public: // Constants
+
+  // Canvas units
+  static constexpr float DEFAULT_CELL_SIZE = 32.f;
+
+public: // Construction
+
+  explicit HandleGrid(
+      const float cell_size = DEFAULT_CELL_SIZE
+    );
+
+public: // Interface
+
+  void Build(
+      const FigureView points
+    );
+
+  void Insert(
+      const std::size_t index,
+      const ImVec2      point
+    );
+
+  // `from` is the position the point was inserted or last moved at
+  void Move(
+      const std::size_t index,
+      const ImVec2      from,
+      const ImVec2      to
+    );
+
+  // Closest point to `position` within `radius`, the earlier index wins a tie
+  std::optional<std::size_t> FindNearest(
+      const FigureView points,
+      const ImVec2     position,
+      const float      radius
+    ) const;
+
+private: // Types
+
+  using Key = std::uint64_t;
+
+private: // Service
+
+  std::int32_t ToCell(
+      const float coordinate
+    ) const;
+
+  static Key GetKey(
+      const std::int32_t x,
+      const std::int32_t y
+    );
+
+  Key GetKey(
+      const ImVec2 point
+    ) const;
+
+private: // Members
+
+  float                                               m_CellSize;
+  std::unordered_map<Key, std::vector<std::uint32_t>> m_Cells;
+};
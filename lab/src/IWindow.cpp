@@ -1,4 +1,5 @@
 #include "IWindow.h"
+#include "FrameCost.h"
 
 #include <imgui.h>
 #include <sstream>
@@ -31,15 +32,17 @@ IWindow::IWindow() :
 // Interface
 //
 
-void IWindow::Show()
+void IWindow::Show(
+    const char * label
+  )
 {
-  ImGui::PushID(this);
+  const FrameCost::Scope Cost(*this);
 
-  auto WindowName = GetWindowName();
+  ImGui::PushID(this);
 
-  WindowName.append("###").append(m_ThisStr);
+  m_IsVisible = ImGui::Begin(label);
 
-  if (ImGui::Begin(WindowName.c_str()))
+  if (m_IsVisible)
     UpdateFrameData();
 
   ImGui::End();
@@ -49,5 +52,15 @@ void IWindow::Show()
 
 std::string IWindow::GetWindowNameID() const
 {
-  return GetWindowName().append("###").append(m_ThisStr);
+  return std::string(GetWindowName()).append("###").append(m_ThisStr);
+}
+
+bool IWindow::IsVisible() const
+{
+  return m_IsVisible;
+}
+
+bool IWindow::IsAnimating() const
+{
+  return false;
 }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 
 class IWindow
 {
@@ -12,18 +13,31 @@ public: // Construction / Destruction
 
 public: // Interface
 
-  void Show();
+  // `label` is the name plus the "###" suffix, WindowRegistry caches it
+  void Show(
+      const char * label
+    );
 
   std::string GetWindowNameID() const;
 
+  // Content submitted in the last Show(), false while collapsed or behind
+  // another tab of its dock node
+  bool IsVisible() const;
+
+  // Whether the window changes on its own every frame or waits for a
+  // background result, see WindowRegistry
+  virtual bool IsAnimating() const;
+
 protected: // Service
 
-  virtual std::string GetWindowName() const = 0;
+  virtual std::string_view GetWindowName() const = 0;
 
   virtual void UpdateFrameData() = 0;
 
 private:
 
+  friend class WindowRegistry;
+
   std::string m_ThisStr;
+  bool        m_IsVisible = false;
 };
-
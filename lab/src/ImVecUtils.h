@@ -1,10 +1,19 @@
 #pragma once
 
+#include "FigureView.h"
+#include "FigureBuffer.h"
+#include "ThreadPool.h"
+#include "FrameArena.h"
+
 #include <imgui.h>
+#include <vector>
+#include <memory_resource>
+#include <array>
 #include <cmath>
-#include <random>
 #include <functional>
 #include <map>
+#include <algorithm>
+#include <cfloat>
 
 inline ImVec2 operator+(ImVec2 lhs, ImVec2 rhs)
 {
@@ -43,6 +52,81 @@ inline float ImVecDistance(ImVec2 lhs, ImVec2 rhs)
   return std::sqrtf(d.x * d.x + d.y * d.y);
 }
 
+// Distance from `point` to the segment [a, b]
+inline float SegmentDistance(ImVec2 point, ImVec2 a, ImVec2 b)
+{
+  const auto ab = b - a;
+  const auto Length2 = ab * ab;
+
+  if (Length2 <= 0)
+    return ImVecDistance(point, a);
+
+  const auto t = std::clamp(((point - a) * ab) / Length2, 0.f, 1.f);
+
+  return ImVecDistance(point, a + ab * t);
+}
+
+struct BoundingBox
+{
+  ImVec2 Min{  FLT_MAX,  FLT_MAX };
+  ImVec2 Max{ -FLT_MAX, -FLT_MAX };
+
+  bool IsEmpty() const
+  {
+    return Min.x > Max.x || Min.y > Max.y;
+  }
+
+  void Add(ImVec2 point)
+  {
+    Min = ImVec2{ std::min(Min.x, point.x), std::min(Min.y, point.y) };
+    Max = ImVec2{ std::max(Max.x, point.x), std::max(Max.y, point.y) };
+  }
+
+  void Expand(float amount)
+  {
+    Min = Min - ImVec2{ amount, amount };
+    Max = Max + ImVec2{ amount, amount };
+  }
+
+  bool Intersects(ImVec2 min, ImVec2 max) const
+  {
+    return Min.x <= max.x && min.x <= Max.x && Min.y <= max.y && min.y <= Max.y;
+  }
+};
+
+inline BoundingBox GetBounds(
+    const FigureView points
+  )
+{
+  BoundingBox Result;
+
+  for (std::size_t i = 0; i < points.Size(); ++i)
+    Result.Add(points[i]);
+
+  return Result;
+}
+
+// Cumulative polyline length up to every point, the first entry is always 0
+inline std::vector<float> GetArcLengths(
+    const FigureView points
+  )
+{
+  std::vector<float> Result;
+  Result.reserve(points.Size());
+
+  float Length = 0;
+
+  for (std::size_t i = 0; i < points.Size(); ++i)
+  {
+    if (i > 0)
+      Length += ImVecDistance(points[i - 1], points[i]);
+
+    Result.push_back(Length);
+  }
+
+  return Result;
+}
+
 inline ImVec2 LinearInterpolate(ImVec2 P1, ImVec2 P2, float t)
 {
   return P1 * (1 - t) + P2 * t;
@@ -130,7 +214,9 @@ inline float GetT(float t, float alpha, const ImVec2 & p0, const ImVec2 & p1)
 {
   auto d = p1 - p0;
   float a = d * d;
-  float b = std::pow(a, alpha * 0.5f);
+  // The centripetal case only needs correctly rounded square roots, which
+  // the GPU spline kernel can reproduce exactly, pow() it can not
+  float b = alpha == .5f ? std::sqrt(std::sqrt(a)) : std::pow(a, alpha * 0.5f);
   return (b + t);
 }
 
@@ -150,108 +236,644 @@ inline ImVec2 CatmullRom(const ImVec2 & p0, const ImVec2 & p1, const ImVec2 & p2
   return C;
 }
 
-inline std::vector<ImVec2> GetSpline(
-    const std::vector<ImVec2> & points,
-    const std::size_t           num_points
+// Tessellation density used to draw figures
+inline constexpr std::size_t SPLINE_POINTS_PER_SEGMENT = 10;
+
+// Below these sizes the kernels stay on the calling thread, the scheduling
+// would cost more than it saves
+inline constexpr std::size_t PARALLEL_SPLINE_THRESHOLD = 1024;  // segments
+inline constexpr std::size_t PARALLEL_SPLINE_GRAIN     = 256;
+inline constexpr std::size_t PARALLEL_FILL_THRESHOLD   = 4096;  // points
+inline constexpr std::size_t PARALLEL_FILL_GRAIN       = 512;
+inline constexpr std::size_t PARALLEL_MORPH_THRESHOLD  = 16384; // points
+inline constexpr std::size_t PARALLEL_MORPH_GRAIN      = 4096;
+inline constexpr std::size_t PARALLEL_BATCH_THRESHOLD  = 65536; // points * outlines
+
+// Control points of the i-th Catmull-Rom segment (between points i and i + 1),
+// the outer control points of the end segments are extrapolated
+inline std::array<ImVec2, 4> GetSplineSegment(
+    const FigureView  points,
+    const std::size_t i
   )
 {
-  if (points.size() < 3)
-    return points;
+  const auto siz = points.Size();
+  const auto p1 = points[i];
+  const auto p2 = points[i + 1];
+
+  return {
+      i == 0 ? 2 * p1 - p2 : points[i - 1],
+      p1,
+      p2,
+      i + 2 == siz ? 2 * p2 - p1 : points[i + 2]
+    };
+}
 
-  std::vector<ImVec2> Result;
+// Number of points GetSpline emits per segment
+inline std::size_t GetSplineSegmentSamples(
+    const std::size_t num_points
+  )
+{
   const float delta = 1.0f / (num_points + 1);
-  const std::size_t siz = points.size();
+  std::size_t Count = 0;
 
   for (float t = 0; t <= 1.0f; t += delta)
-    Result.push_back(CatmullRom(2 * points[0] - points[1], points[0], points[1], points[2], t));
+    ++Count;
 
-  for (std::size_t i = 1; i < siz - 2; ++i)
-    for (float t = 0; t <= 1.0f; t += delta)
-      Result.push_back(CatmullRom(points[i - 1], points[i], points[i + 1], points[i + 2], t));
+  return Count;
+}
 
+inline void TessellateSplineSegment(
+    const FigureView  points,
+    const std::size_t i,
+    const std::size_t num_points,
+    ImVec2 *          out
+  )
+{
+  const auto [p0, p1, p2, p3] = GetSplineSegment(points, i);
+  const float delta = 1.0f / (num_points + 1);
 
   for (float t = 0; t <= 1.0f; t += delta)
-    Result.push_back(CatmullRom(points[siz - 3], points[siz - 2], points[siz - 1], 2 * points[siz - 1] - points[siz - 2], t));
+    *out++ = CatmullRom(p0, p1, p2, p3, t);
+}
+
+// Replaces the contents of `out` (any vector of ImVec2) with the points
+template <class Points>
+inline void AssignPoints(
+    const FigureView points,
+    Points &         out
+  )
+{
+  out.resize(points.Size());
+
+  for (std::size_t i = 0; i < points.Size(); ++i)
+    out[i] = points[i];
+}
+
+template <class Points>
+inline void GetSplineInto(
+    const FigureView  points,
+    const std::size_t num_points,
+    Points &          out
+  )
+{
+  if (points.Size() < 3)
+  {
+    AssignPoints(points, out);
+    return;
+  }
+
+  const std::size_t Segments = points.Size() - 1;
+  const std::size_t Samples = GetSplineSegmentSamples(num_points);
+
+  out.resize(Segments * Samples);
+
+  const auto Tessellate = [&](const std::size_t begin, const std::size_t end)
+  {
+    for (std::size_t i = begin; i < end; ++i)
+      TessellateSplineSegment(points, i, num_points, out.data() + i * Samples);
+  };
+
+  if (Segments < PARALLEL_SPLINE_THRESHOLD)
+    Tessellate(0, Segments);
+  else
+    ThreadPool::Instance().ParallelFor(0, Segments, PARALLEL_SPLINE_GRAIN, Tessellate);
+}
 
+inline std::vector<ImVec2> GetSpline(
+    const FigureView  points,
+    const std::size_t num_points
+  )
+{
+  std::vector<ImVec2> Result;
+  GetSplineInto(points, num_points, Result);
+  return Result;
+}
+
+// Frame temporary, see FrameArena
+inline std::pmr::vector<ImVec2> GetSpline(
+    const FigureView            points,
+    const std::size_t           num_points,
+    std::pmr::memory_resource & arena
+  )
+{
+  std::pmr::vector<ImVec2> Result(&arena);
+  GetSplineInto(points, num_points, Result);
   return Result;
 }
 
+// Draws `pos + point * scale` for every point, scale is the canvas zoom
+inline void DrawPolyline(
+    const FigureView points,
+    const ImVec2 pos,
+    const ImU32 col = 0xFFFFFFFF,
+    const float thickness = 1,
+    const float scale = 1
+  )
+{
+  if (points.Size() < 2)
+    return;
+
+  auto * DrawList = ImGui::GetWindowDrawList();
+
+  // Lines outside the clip rect would only produce clipped-away vertices
+  const auto Margin = ImVec2{ thickness, thickness };
+  const auto ClipMin = (DrawList->GetClipRectMin() - pos - Margin) / scale;
+  const auto ClipMax = (DrawList->GetClipRectMax() - pos + Margin) / scale;
+
+  for (int i = 0; i < points.Size() - 1; ++i)
+  {
+    const auto a = points[i];
+    const auto b = points[i + 1];
+
+    if (std::max(a.x, b.x) < ClipMin.x || std::min(a.x, b.x) > ClipMax.x ||
+        std::max(a.y, b.y) < ClipMin.y || std::min(a.y, b.y) > ClipMax.y)
+      continue;
+
+    DrawList->AddLine(pos + a * scale, pos + b * scale, col, thickness);
+  }
+}
+
 inline void DrawFigure(
-    const std::vector<ImVec2> & points,
+    const FigureView points,
     const ImVec2 pos,
     const ImU32 col = 0xFFFFFFFF,
-    const float thickness = 1
+    const float thickness = 1,
+    const float scale = 1
   )
 {
-  if (points.size() < 2)
+  if (points.Size() < 2)
     return;
 
-  const auto Spline = GetSpline(points, 10);
+  DrawPolyline(GetSpline(points, SPLINE_POINTS_PER_SEGMENT, FrameArena::GetResource()), pos, col, thickness, scale);
+}
 
-  for (int i = 0; i < Spline.size() - 1; ++i)
+// Ramer-Douglas-Peucker over `count` points. `deviation(i, a, b)` returns
+// how far point i is from the chord between points a and b. Returns the
+// indices of the kept points, the first and the last one are always kept.
+template <class Deviation>
+inline std::vector<std::size_t> SimplifyIndices(
+    const std::size_t count,
+    const float       tolerance,
+    Deviation &&      deviation
+  )
+{
+  if (count < 3)
   {
-    int next = (i == Spline.size() - 1 ? 0 : i + 1);
+    std::vector<std::size_t> Result;
 
-    ImGui::GetWindowDrawList()->AddLine(
-      pos + Spline[i],
-      pos + Spline[i + 1],
-      col, thickness
-    );
+    for (std::size_t i = 0; i < count; ++i)
+      Result.push_back(i);
+
+    return Result;
   }
+
+  std::vector<bool> Keep(count, false);
+  Keep.front() = Keep.back() = true;
+
+  std::vector<std::pair<std::size_t, std::size_t>> Stack{ { 0, count - 1 } };
+
+  while (!Stack.empty())
+  {
+    const auto [First, Last] = Stack.back();
+    Stack.pop_back();
+
+    float MaxDeviation = 0;
+    std::size_t Farthest = First;
+
+    for (std::size_t i = First + 1; i < Last; ++i)
+    {
+      const auto Current = deviation(i, First, Last);
+
+      if (Current > MaxDeviation)
+      {
+        MaxDeviation = Current;
+        Farthest = i;
+      }
+    }
+
+    if (MaxDeviation <= tolerance)
+      continue;
+
+    Keep[Farthest] = true;
+    Stack.push_back({ First, Farthest });
+    Stack.push_back({ Farthest, Last });
+  }
+
+  std::vector<std::size_t> Result;
+
+  for (std::size_t i = 0; i < count; ++i)
+    if (Keep[i])
+      Result.push_back(i);
+
+  return Result;
 }
 
-inline std::pair<std::vector<ImVec2>, std::vector<ImVec2>> FillMissingPoints(
-    const std::vector<ImVec2> & first,
-    const std::vector<ImVec2> & second
+inline std::vector<ImVec2> SimplifyPolyline(
+    const FigureView points,
+    const float      tolerance
+  )
+{
+  const auto Indices = SimplifyIndices(points.Size(), tolerance, [&](std::size_t i, std::size_t a, std::size_t b)
+  {
+    return SegmentDistance(points[i], points[a], points[b]);
+  });
+
+  std::vector<ImVec2> Result;
+  Result.reserve(Indices.size());
+
+  for (const auto i : Indices)
+    Result.push_back(points[i]);
+
+  return Result;
+}
+
+// Resamples `points` to `count` points and calls `set(index, point)` for
+// every one of them: the missing points are spread evenly over the
+// segments and taken from the Catmull-Rom curve through them. Every
+// segment is filled independently, so the result is the same whether the
+// segments run on one thread or on the pool.
+template <class Set>
+inline void ForEachEvenSample(
+    const FigureView  points,
+    const std::size_t count,
+    const Set &       set
+  )
+{
+  if (points.Size() == 1)
+  {
+    for (std::size_t i = 0; i < count; ++i)
+      set(i, points[0]);
+
+    return;
+  }
+
+  const std::size_t Segments = points.Size() - 1;
+  const std::size_t Extra = count - points.Size();
+
+  const auto Fill = [&](const std::size_t begin, const std::size_t end)
+  {
+    for (std::size_t i = begin; i < end; ++i)
+    {
+      const auto [p0, p1, p2, p3] = GetSplineSegment(points, i);
+      const auto Offset = i + i * Extra / Segments;
+      const auto Inserted = (i + 1) * Extra / Segments - i * Extra / Segments;
+
+      set(Offset, p1);
+
+      for (std::size_t k = 1; k <= Inserted; ++k)
+        set(Offset + k, CatmullRom(p0, p1, p2, p3, float(k) / (Inserted + 1)));
+    }
+  };
+
+  if (count < PARALLEL_FILL_THRESHOLD)
+    Fill(0, Segments);
+  else
+    ThreadPool::Instance().ParallelFor(0, Segments, PARALLEL_FILL_GRAIN, Fill);
+
+  set(count - 1, points.Back());
+}
+
+template <class Points>
+inline void FillMissingPointsEvenly(
+    const FigureView  points,
+    const std::size_t count,
+    Points &          out
+  )
+{
+  out.resize(count);
+  ForEachEvenSample(points, count, [&](const std::size_t i, const ImVec2 point) { out[i] = point; });
+}
+
+// Resamples the smaller figure to the point count of the larger one, the
+// results go to `out_first` and `out_second`
+template <class Points>
+inline void FillMissingPointsInto(
+    const FigureView first,
+    const FigureView second,
+    Points &         out_first,
+    Points &         out_second
   )
 {
-  if (first.size() == second.size() || first.size() == 0 || second.size() == 0)
-    return { first, second };
+  if (first.Size() == second.Size() || first.Size() == 0 || second.Size() == 0)
+  {
+    AssignPoints(first, out_first);
+    AssignPoints(second, out_second);
+    return;
+  }
 
-  const auto max_count = std::max(first.size(), second.size());
+  const auto max_count = std::max(first.Size(), second.Size());
+  const bool IsFirstSmaller = first.Size() < second.Size();
 
-  std::vector<ImVec2> copy = (first.size() < second.size() ? first : second);
+  AssignPoints(IsFirstSmaller ? second : first, IsFirstSmaller ? out_second : out_first);
+  FillMissingPointsEvenly(IsFirstSmaller ? first : second, max_count, IsFirstSmaller ? out_first : out_second);
+}
 
-  std::default_random_engine eng;
+inline std::pair<std::vector<ImVec2>, std::vector<ImVec2>> FillMissingPoints(
+    const FigureView first,
+    const FigureView second
+  )
+{
+  std::pair<std::vector<ImVec2>, std::vector<ImVec2>> Result;
+  FillMissingPointsInto(first, second, Result.first, Result.second);
+  return Result;
+}
 
-  while (copy.size() < max_count)
+// Frame temporaries, see FrameArena
+inline std::pair<std::pmr::vector<ImVec2>, std::pmr::vector<ImVec2>> FillMissingPoints(
+    const FigureView            first,
+    const FigureView            second,
+    std::pmr::memory_resource & arena
+  )
+{
+  std::pair<std::pmr::vector<ImVec2>, std::pmr::vector<ImVec2>> Result{ std::pmr::vector<ImVec2>(&arena), std::pmr::vector<ImVec2>(&arena) };
+  FillMissingPointsInto(first, second, Result.first, Result.second);
+  return Result;
+}
+
+template <class Points>
+inline void MorphInto(
+    const FigureView                                     _First,
+    const FigureView                                     _Second,
+    const float                                          _Time,
+    const std::function<ImVec2(ImVec2, ImVec2, float)> & _InterpolateFunc,
+    Points &                                             _Out
+  )
+{
+  if (_First.Size() < 2 || _Second.Size() < 2 || _First.Size() != _Second.Size())
   {
-    std::uniform_int_distribution<int> distr(0, copy.size() - 2);
-    const int pos = distr(eng);
-
-    if (pos == 0)
-      copy.insert(copy.begin() + pos + 1, CatmullRom(2 * copy[0] - copy[1], copy[0], copy[1], copy[2], 0.5));
-    else
-    if (pos + 2 == copy.size())
-      copy.insert(copy.begin() + pos + 1, CatmullRom(copy[pos - 2], copy[pos - 1], copy[pos], 2 * copy[pos + 1] - copy[pos], 0.5));
-    else
-      copy.insert(copy.begin() + pos + 1, CatmullRom(copy[pos - 1], copy[pos], copy[pos + 1], copy[pos + 2], 0.5));
+    _Out.clear();
+    return;
   }
 
-  if (first.size() < second.size())
-    return { std::move(copy), second };
+  _Out.resize(_First.Size());
 
-  return { first, std::move(copy) };
+  const auto Interpolate = [&](const std::size_t begin, const std::size_t end)
+  {
+    for (std::size_t i = begin; i < end; ++i)
+      _Out[i] = _InterpolateFunc(_First[i], _Second[i], _Time);
+  };
+
+  if (_First.Size() < PARALLEL_MORPH_THRESHOLD)
+    Interpolate(0, _First.Size());
+  else
+    ThreadPool::Instance().ParallelFor(0, _First.Size(), PARALLEL_MORPH_GRAIN, Interpolate);
 }
 
 inline std::vector<ImVec2> Morph(
-    const std::vector<ImVec2> &                          _First,
-    const std::vector<ImVec2> &                          _Second,
+    const FigureView                                     _First,
+    const FigureView                                     _Second,
     const float                                          _Time,
     const std::function<ImVec2(ImVec2, ImVec2, float)> & _InterpolateFunc
   )
 {
-  if (_First.size() < 2 || _Second.size() < 2)
-    return {};
+  std::vector<ImVec2> Result;
+  MorphInto(_First, _Second, _Time, _InterpolateFunc, Result);
+  return Result;
+}
 
-  if (_First.size() != _Second.size())
-    return {};
+// Frame temporary, see FrameArena
+inline std::pmr::vector<ImVec2> Morph(
+    const FigureView                                     _First,
+    const FigureView                                     _Second,
+    const float                                          _Time,
+    const std::function<ImVec2(ImVec2, ImVec2, float)> & _InterpolateFunc,
+    std::pmr::memory_resource &                          _Arena
+  )
+{
+  std::pmr::vector<ImVec2> Result(&_Arena);
+  MorphInto(_First, _Second, _Time, _InterpolateFunc, Result);
+  return Result;
+}
 
-  std::vector<ImVec2> Result;
-  Result.reserve(_First.size());
+// Linear morphs of the figures for every weight in one sweep over the
+// points: each pair is read once and written to all the outlines. Outline
+// k occupies [k * n, (k + 1) * n) of `out`.
+inline void MorphBatch(
+    const FigureView           first,
+    const FigureView           second,
+    const std::vector<float> & weights,
+    std::vector<ImVec2> &      out
+  )
+{
+  const auto n = first.Size();
 
-  for (int i = 0; i < _First.size(); ++i)
-    Result.push_back(_InterpolateFunc(_First[i], _Second[i], _Time));
+  out.resize(first.Size() == second.Size() ? n * weights.size() : 0);
 
-  return Result;
-}
\ No newline at end of file
+  if (out.empty())
+    return;
+
+  const auto Interpolate = [&](const std::size_t begin, const std::size_t end)
+  {
+    for (std::size_t i = begin; i < end; ++i)
+    {
+      const auto a = first[i];
+      const auto d = second[i] - a;
+
+      for (std::size_t k = 0; k < weights.size(); ++k)
+        out[k * n + i] = a + d * weights[k];
+    }
+  };
+
+  if (out.size() < PARALLEL_BATCH_THRESHOLD)
+    Interpolate(0, n);
+  else
+    ThreadPool::Instance().ParallelFor(0, n, PARALLEL_MORPH_GRAIN, Interpolate);
+}
+
+//
+// FigureBuffer overloads: the kernels write the x and y arrays directly
+//
+
+inline void TessellateSplineSegment(
+    const FigureView  points,
+    const std::size_t i,
+    const std::size_t num_points,
+    float *           out_x,
+    float *           out_y
+  )
+{
+  const auto [p0, p1, p2, p3] = GetSplineSegment(points, i);
+  const float delta = 1.0f / (num_points + 1);
+
+  for (float t = 0; t <= 1.0f; t += delta)
+  {
+    const auto Point = CatmullRom(p0, p1, p2, p3, t);
+    *out_x++ = Point.x;
+    *out_y++ = Point.y;
+  }
+}
+
+inline void GetSplineInto(
+    const FigureView  points,
+    const std::size_t num_points,
+    FigureBuffer &    out
+  )
+{
+  if (points.Size() < 3)
+  {
+    out.Assign(points);
+    return;
+  }
+
+  const std::size_t Segments = points.Size() - 1;
+  const std::size_t Samples = GetSplineSegmentSamples(num_points);
+
+  out.Resize(Segments * Samples);
+
+  const auto Tessellate = [&](const std::size_t begin, const std::size_t end)
+  {
+    for (std::size_t i = begin; i < end; ++i)
+      TessellateSplineSegment(points, i, num_points, out.X() + i * Samples, out.Y() + i * Samples);
+  };
+
+  if (Segments < PARALLEL_SPLINE_THRESHOLD)
+    Tessellate(0, Segments);
+  else
+    ThreadPool::Instance().ParallelFor(0, Segments, PARALLEL_SPLINE_GRAIN, Tessellate);
+}
+
+inline void FillMissingPointsEvenly(
+    const FigureView  points,
+    const std::size_t count,
+    FigureBuffer &    out
+  )
+{
+  out.Resize(count);
+  ForEachEvenSample(points, count, [&](const std::size_t i, const ImVec2 point) { out.Set(i, point); });
+}
+
+inline void FillMissingPointsInto(
+    const FigureView first,
+    const FigureView second,
+    FigureBuffer &   out_first,
+    FigureBuffer &   out_second
+  )
+{
+  if (first.Size() == second.Size() || first.Size() == 0 || second.Size() == 0)
+  {
+    out_first.Assign(first);
+    out_second.Assign(second);
+    return;
+  }
+
+  const auto max_count = std::max(first.Size(), second.Size());
+  const bool IsFirstSmaller = first.Size() < second.Size();
+
+  (IsFirstSmaller ? out_second : out_first).Assign(IsFirstSmaller ? second : first);
+  FillMissingPointsEvenly(IsFirstSmaller ? first : second, max_count, IsFirstSmaller ? out_first : out_second);
+}
+
+inline void MorphInto(
+    const FigureView                                     _First,
+    const FigureView                                     _Second,
+    const float                                          _Time,
+    const std::function<ImVec2(ImVec2, ImVec2, float)> & _InterpolateFunc,
+    FigureBuffer &                                       _Out
+  )
+{
+  if (_First.Size() < 2 || _Second.Size() < 2 || _First.Size() != _Second.Size())
+  {
+    _Out.Clear();
+    return;
+  }
+
+  _Out.Resize(_First.Size());
+
+  const auto Interpolate = [&](const std::size_t begin, const std::size_t end)
+  {
+    for (std::size_t i = begin; i < end; ++i)
+      _Out.Set(i, _InterpolateFunc(_First[i], _Second[i], _Time));
+  };
+
+  if (_First.Size() < PARALLEL_MORPH_THRESHOLD)
+    Interpolate(0, _First.Size());
+  else
+    ThreadPool::Instance().ParallelFor(0, _First.Size(), PARALLEL_MORPH_GRAIN, Interpolate);
+}
+
+// MorphInto with LinearInterpolate, without the per-point std::function
+// call. Stride 1 inputs run as plain float loops the compiler vectorizes.
+inline void MorphLinearInto(
+    const FigureView first,
+    const FigureView second,
+    const float      t,
+    FigureBuffer &   out
+  )
+{
+  if (first.Size() < 2 || second.Size() < 2 || first.Size() != second.Size())
+  {
+    out.Clear();
+    return;
+  }
+
+  out.Resize(first.Size());
+
+  const auto Interpolate = [&](const std::size_t begin, const std::size_t end)
+  {
+    if (first.Stride() != 1 || second.Stride() != 1)
+    {
+      for (std::size_t i = begin; i < end; ++i)
+        out.Set(i, LinearInterpolate(first[i], second[i], t));
+
+      return;
+    }
+
+    const float * AX = first.X();
+    const float * AY = first.Y();
+    const float * BX = second.X();
+    const float * BY = second.Y();
+    float * X = out.X();
+    float * Y = out.Y();
+
+    for (std::size_t i = begin; i < end; ++i)
+      X[i] = AX[i] * (1 - t) + BX[i] * t;
+
+    for (std::size_t i = begin; i < end; ++i)
+      Y[i] = AY[i] * (1 - t) + BY[i] * t;
+  };
+
+  if (first.Size() < PARALLEL_MORPH_THRESHOLD)
+    Interpolate(0, first.Size());
+  else
+    ThreadPool::Instance().ParallelFor(0, first.Size(), PARALLEL_MORPH_GRAIN, Interpolate);
+}
+
+// Outline k occupies [k * n, (k + 1) * n) of both arrays of `out`, so every
+// outline is a stride 1 view
+inline void MorphBatch(
+    const FigureView           first,
+    const FigureView           second,
+    const std::vector<float> & weights,
+    FigureBuffer &             out
+  )
+{
+  const auto n = first.Size();
+
+  out.Resize(first.Size() == second.Size() ? n * weights.size() : 0);
+
+  if (out.Empty())
+    return;
+
+  float * X = out.X();
+  float * Y = out.Y();
+
+  const auto Interpolate = [&](const std::size_t begin, const std::size_t end)
+  {
+    for (std::size_t i = begin; i < end; ++i)
+    {
+      const auto a = first[i];
+      const auto d = second[i] - a;
+
+      for (std::size_t k = 0; k < weights.size(); ++k)
+      {
+        X[k * n + i] = a.x + d.x * weights[k];
+        Y[k * n + i] = a.y + d.y * weights[k];
+      }
+    }
+  };
+
+  if (out.Size() < PARALLEL_BATCH_THRESHOLD)
+    Interpolate(0, n);
+  else
+    ThreadPool::Instance().ParallelFor(0, n, PARALLEL_MORPH_GRAIN, Interpolate);
+}
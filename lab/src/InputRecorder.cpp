@@ -0,0 +1,411 @@
+#include "InputRecorder.h"
+
+#include <imgui.h>
+#define GLFW_INCLUDE_NONE
+#include <GLFW/glfw3.h>
+
+#include <algorithm>
+#include <iostream>
+#include <stdexcept>
+#include <cstring>
+#include <cstdio>
+
+namespace
+{
+
+constexpr char          INPUT_LOG_MAGIC[8] = { 'M', 'I', 'N', 'P', 'U', 'T', 'L', '\0' };
+constexpr std::uint32_t INPUT_LOG_VERSION  = 1;
+
+struct InputLogHeader
+{
+  char          Magic[8];
+  std::uint32_t Version;
+  std::uint32_t EventSize;
+};
+
+static_assert(sizeof(InputEvent) == 24, "Input log event layout changed");
+
+} // namespace
+
+//
+// Interface
+//
+
+InputRecorder & InputRecorder::Instance()
+{
+  static InputRecorder Recorder;
+  return Recorder;
+}
+
+void InputRecorder::StartRecording(
+    const std::string & path
+  )
+{
+  m_Out.open(path, std::ios::binary | std::ios::trunc);
+
+  if (!m_Out)
+    throw std::runtime_error("Input recorder: Failed to open " + path);
+
+  InputLogHeader Header = {};
+  std::memcpy(Header.Magic, INPUT_LOG_MAGIC, sizeof(INPUT_LOG_MAGIC));
+  Header.Version = INPUT_LOG_VERSION;
+  Header.EventSize = sizeof(InputEvent);
+  m_Out.write(reinterpret_cast<const char *>(&Header), sizeof(Header));
+
+  m_Path = path;
+  m_Mode = Mode::Record;
+}
+
+void InputRecorder::StartReplay(
+    const std::string & path,
+    const bool          exit_at_end
+  )
+{
+  std::ifstream In(path, std::ios::binary);
+
+  if (!In)
+    throw std::runtime_error("Input recorder: Failed to open " + path);
+
+  InputLogHeader Header;
+
+  if (!In.read(reinterpret_cast<char *>(&Header), sizeof(Header))
+   || std::memcmp(Header.Magic, INPUT_LOG_MAGIC, sizeof(INPUT_LOG_MAGIC)) != 0
+   || Header.Version != INPUT_LOG_VERSION
+   || Header.EventSize != sizeof(InputEvent))
+    throw std::runtime_error("Input recorder: " + path + " is not an input log of this version");
+
+  // A log cut short by a crash ends at its last complete event
+  m_Events.clear();
+
+  InputEvent Event;
+
+  while (In.read(reinterpret_cast<char *>(&Event), sizeof(Event)))
+    m_Events.push_back(Event);
+
+  m_Path = path;
+  m_Next = 0;
+  m_ExitAtEnd = exit_at_end;
+  m_FrameTimes.clear();
+  m_Mode = Mode::Replay;
+}
+
+void InputRecorder::Attach(
+    GLFWwindow * window
+  )
+{
+  if (m_Mode == Mode::Off)
+    return;
+
+  m_Window = window;
+  m_StartTime = glfwGetTime();
+
+  // Saved layouts would move the windows the input was aimed at
+  ImGui::GetIO().IniFilename = nullptr;
+
+  m_PrevWindowFocus = glfwSetWindowFocusCallback(window, window_focus_callback);
+  m_PrevCursorEnter = glfwSetCursorEnterCallback(window, cursor_enter_callback);
+  m_PrevCursorPos = glfwSetCursorPosCallback(window, cursor_pos_callback);
+  m_PrevMouseButton = glfwSetMouseButtonCallback(window, mouse_button_callback);
+  m_PrevScroll = glfwSetScrollCallback(window, scroll_callback);
+  m_PrevKey = glfwSetKeyCallback(window, key_callback);
+  m_PrevChar = glfwSetCharCallback(window, char_callback);
+}
+
+void InputRecorder::BeginFrame()
+{
+  if (m_Mode == Mode::Record)
+  {
+    InputEvent Event;
+    Event.Type = InputEventType::Frame;
+    glfwGetWindowSize(m_Window, &Event.Code, &Event.Scancode);
+    Write(Event);
+    return;
+  }
+
+  if (m_Mode != Mode::Replay)
+    return;
+
+  // The time between two frame starts covers the whole previous frame,
+  // presentation included
+  const auto Now = std::chrono::steady_clock::now();
+
+  if (m_Next > 0)
+    m_FrameTimes.push_back(std::chrono::duration<float, std::milli>(Now - m_LastFrame).count());
+
+  m_LastFrame = Now;
+
+  if (m_Next == m_Events.size())
+  {
+    EndReplay();
+    return;
+  }
+
+  while (m_Next < m_Events.size())
+  {
+    const auto & Event = m_Events[m_Next++];
+    Dispatch(Event);
+
+    if (Event.Type == InputEventType::Frame)
+      break;
+  }
+}
+
+void InputRecorder::ApplyDeltaTime()
+{
+  if (m_Mode == Mode::Replay)
+    ImGui::GetIO().DeltaTime = REPLAY_DELTA_TIME;
+}
+
+void InputRecorder::Finish()
+{
+  if (m_Mode == Mode::Record)
+  {
+    m_Out.close();
+    std::cout << "Input recorded to " << m_Path << std::endl;
+  }
+  else
+  if (m_Mode == Mode::Replay)
+  {
+    std::cout << "Replay interrupted after " << m_FrameTimes.size() << " frames" << std::endl;
+    PrintReport();
+  }
+
+  m_Mode = Mode::Off;
+}
+
+InputRecorder::Mode InputRecorder::GetMode() const
+{
+  return m_Mode;
+}
+
+//
+// Service
+//
+
+void InputRecorder::Write(
+    InputEvent event
+  )
+{
+  event.Time = float(glfwGetTime() - m_StartTime);
+  m_Out.write(reinterpret_cast<const char *>(&event), sizeof(event));
+}
+
+bool InputRecorder::Capture(
+    const InputEvent & event
+  )
+{
+  if (m_Mode == Mode::Record)
+    Write(event);
+
+  return m_Mode != Mode::Replay;
+}
+
+void InputRecorder::Dispatch(
+    const InputEvent & event
+  )
+{
+  switch (event.Type)
+  {
+  case InputEventType::Frame:
+  {
+    int Width, Height;
+    glfwGetWindowSize(m_Window, &Width, &Height);
+
+    if (event.Code > 0 && event.Scancode > 0 && (Width != event.Code || Height != event.Scancode))
+      glfwSetWindowSize(m_Window, event.Code, event.Scancode);
+
+    break;
+  }
+  case InputEventType::CursorPos:
+    if (m_PrevCursorPos)
+      m_PrevCursorPos(m_Window, event.X, event.Y);
+    break;
+  case InputEventType::CursorEnter:
+    if (m_PrevCursorEnter)
+      m_PrevCursorEnter(m_Window, event.Action);
+    break;
+  case InputEventType::MouseButton:
+    if (m_PrevMouseButton)
+      m_PrevMouseButton(m_Window, event.Code, event.Action, event.Mods);
+    break;
+  case InputEventType::Scroll:
+    if (m_PrevScroll)
+      m_PrevScroll(m_Window, event.X, event.Y);
+    break;
+  case InputEventType::Key:
+    if (m_PrevKey)
+      m_PrevKey(m_Window, event.Code, event.Scancode, event.Action, event.Mods);
+    break;
+  case InputEventType::Char:
+    if (m_PrevChar)
+      m_PrevChar(m_Window, static_cast<unsigned int>(event.Code));
+    break;
+  case InputEventType::Focus:
+    if (m_PrevWindowFocus)
+      m_PrevWindowFocus(m_Window, event.Action);
+    break;
+  }
+}
+
+void InputRecorder::EndReplay()
+{
+  m_Mode = Mode::Off;
+  PrintReport();
+
+  if (m_ExitAtEnd)
+    glfwSetWindowShouldClose(m_Window, GLFW_TRUE);
+}
+
+void InputRecorder::PrintReport() const
+{
+  if (m_FrameTimes.empty())
+  {
+    std::cout << "Replay of " << m_Path << ": no frames" << std::endl;
+    return;
+  }
+
+  auto Sorted = m_FrameTimes;
+  std::sort(Sorted.begin(), Sorted.end());
+
+  const auto Percentile = [&Sorted](const float p) { return Sorted[std::min(Sorted.size() - 1, std::size_t(p * Sorted.size()))]; };
+
+  float Total = 0;
+
+  for (const auto Time : m_FrameTimes)
+    Total += Time;
+
+  const float Average = Total / m_FrameTimes.size();
+
+  char Line[512];
+  std::snprintf(Line, sizeof(Line), "Replay of %s: %d frames in %.2f s, avg %.2f ms (%.1f fps), p50 %.2f ms, p95 %.2f ms, p99 %.2f ms, max %.2f ms\n",
+      m_Path.c_str(), int(m_FrameTimes.size()), Total / 1000, Average, 1000 / Average,
+      Percentile(0.5f), Percentile(0.95f), Percentile(0.99f), Sorted.back());
+  std::cout << Line << std::flush;
+
+  // Per-frame times for comparing runs of different builds
+  const auto CsvPath = m_Path + ".frames.csv";
+  std::ofstream Csv(CsvPath, std::ios::trunc);
+  Csv << "frame,ms\n";
+
+  for (std::size_t i = 0; i < m_FrameTimes.size(); ++i)
+    Csv << i << ',' << m_FrameTimes[i] << '\n';
+
+  if (!Csv)
+    std::cerr << "Input recorder: Failed to write " << CsvPath << std::endl;
+}
+
+//
+// Static service
+//
+
+void InputRecorder::window_focus_callback(
+    GLFWwindow * window,
+    int          focused
+  )
+{
+  auto & Recorder = Instance();
+  InputEvent Event;
+  Event.Type = InputEventType::Focus;
+  Event.Action = std::uint8_t(focused);
+
+  if (Recorder.Capture(Event) && Recorder.m_PrevWindowFocus)
+    Recorder.m_PrevWindowFocus(window, focused);
+}
+
+void InputRecorder::cursor_enter_callback(
+    GLFWwindow * window,
+    int          entered
+  )
+{
+  auto & Recorder = Instance();
+  InputEvent Event;
+  Event.Type = InputEventType::CursorEnter;
+  Event.Action = std::uint8_t(entered);
+
+  if (Recorder.Capture(Event) && Recorder.m_PrevCursorEnter)
+    Recorder.m_PrevCursorEnter(window, entered);
+}
+
+void InputRecorder::cursor_pos_callback(
+    GLFWwindow * window,
+    double       x,
+    double       y
+  )
+{
+  auto & Recorder = Instance();
+  InputEvent Event;
+  Event.Type = InputEventType::CursorPos;
+  Event.X = float(x);
+  Event.Y = float(y);
+
+  if (Recorder.Capture(Event) && Recorder.m_PrevCursorPos)
+    Recorder.m_PrevCursorPos(window, x, y);
+}
+
+void InputRecorder::mouse_button_callback(
+    GLFWwindow * window,
+    int          button,
+    int          action,
+    int          mods
+  )
+{
+  auto & Recorder = Instance();
+  InputEvent Event;
+  Event.Type = InputEventType::MouseButton;
+  Event.Code = button;
+  Event.Action = std::uint8_t(action);
+  Event.Mods = std::uint16_t(mods);
+
+  if (Recorder.Capture(Event) && Recorder.m_PrevMouseButton)
+    Recorder.m_PrevMouseButton(window, button, action, mods);
+}
+
+void InputRecorder::scroll_callback(
+    GLFWwindow * window,
+    double       x,
+    double       y
+  )
+{
+  auto & Recorder = Instance();
+  InputEvent Event;
+  Event.Type = InputEventType::Scroll;
+  Event.X = float(x);
+  Event.Y = float(y);
+
+  if (Recorder.Capture(Event) && Recorder.m_PrevScroll)
+    Recorder.m_PrevScroll(window, x, y);
+}
+
+void InputRecorder::key_callback(
+    GLFWwindow * window,
+    int          key,
+    int          scancode,
+    int          action,
+    int          mods
+  )
+{
+  auto & Recorder = Instance();
+  InputEvent Event;
+  Event.Type = InputEventType::Key;
+  Event.Code = key;
+  Event.Scancode = scancode;
+  Event.Action = std::uint8_t(action);
+  Event.Mods = std::uint16_t(mods);
+
+  if (Recorder.Capture(Event) && Recorder.m_PrevKey)
+    Recorder.m_PrevKey(window, key, scancode, action, mods);
+}
+
+void InputRecorder::char_callback(
+    GLFWwindow * window,
+    unsigned int codepoint
+  )
+{
+  auto & Recorder = Instance();
+  InputEvent Event;
+  Event.Type = InputEventType::Char;
+  Event.Code = std::int32_t(codepoint);
+
+  if (Recorder.Capture(Event) && Recorder.m_PrevChar)
+    Recorder.m_PrevChar(window, codepoint);
+}
@@ -0,0 +1,189 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include <chrono>
+#include <cstdint>
+
+struct GLFWwindow;
+
+//
+// Records the GLFW input of the main window (cursor, buttons, wheel, keys,
+// focus, window size and timestamps) to a compact binary log and replays
+// it frame by frame.
+//
+// The recorder installs its callbacks on top of the ImGui GLFW backend and
+// forwards to it, CursorCapture sits below the backend and sees the same
+// events. A replay drops live input and feeds the logged events of each
+// frame to the same chain right after the events are polled, with a fixed
+// DeltaTime, then prints a frame-time report. Both sessions start without
+// imgui.ini so the layout the input was recorded against is reproduced.
+//
+
+enum class InputEventType : std::uint8_t
+{
+  Frame,       // Ends the events polled for a frame, Code x Scancode is the window size
+  CursorPos,
+  CursorEnter,
+  MouseButton,
+  Scroll,
+  Key,
+  Char,
+  Focus,
+};
+
+struct InputEvent
+{
+  InputEventType Type     = InputEventType::Frame;
+  std::uint8_t   Action   = 0; // GLFW action, entered or focused flag
+  std::uint16_t  Mods     = 0;
+  std::int32_t   Code     = 0; // Key, mouse button or codepoint
+  std::int32_t   Scancode = 0;
+  float          Time     = 0; // Seconds since the recording started
+  float          X        = 0; // Cursor position or scroll offset
+  float          Y        = 0;
+};
+
+class InputRecorder
+{
+public: // Types
+
+  enum class Mode
+  {
+    Off,
+    Record,
+    Replay,
+  };
+
+public: // Interface
+
+  static InputRecorder & Instance();
+
+  void StartRecording(
+      const std::string & path
+    );
+
+  // With exit_at_end the window is closed once the log is exhausted,
+  // otherwise live input takes over
+  void StartReplay(
+      const std::string & path,
+      const bool          exit_at_end
+    );
+
+  // Must be called after the ImGui GLFW backend installs its callbacks
+  void Attach(
+      GLFWwindow * window
+    );
+
+  // After the events are polled: ends the frame in the log or feeds the
+  // events of the next logged frame
+  void BeginFrame();
+
+  // After the platform backend's NewFrame, before ImGui::NewFrame
+  void ApplyDeltaTime();
+
+  // Closes the log or reports an unfinished replay
+  void Finish();
+
+  Mode GetMode() const;
+
+private: // Service
+
+  void Write(
+      InputEvent event
+    );
+
+  // Logs a live event, false while a replay owns the input
+  bool Capture(
+      const InputEvent & event
+    );
+
+  void Dispatch(
+      const InputEvent & event
+    );
+
+  void EndReplay();
+
+  void PrintReport() const;
+
+private: // Static service
+
+  static void window_focus_callback(
+      GLFWwindow * window,
+      int          focused
+    );
+
+  static void cursor_enter_callback(
+      GLFWwindow * window,
+      int          entered
+    );
+
+  static void cursor_pos_callback(
+      GLFWwindow * window,
+      double       x,
+      double       y
+    );
+
+  static void mouse_button_callback(
+      GLFWwindow * window,
+      int          button,
+      int          action,
+      int          mods
+    );
+
+  static void scroll_callback(
+      GLFWwindow * window,
+      double       x,
+      double       y
+    );
+
+  static void key_callback(
+      GLFWwindow * window,
+      int          key,
+      int          scancode,
+      int          action,
+      int          mods
+    );
+
+  static void char_callback(
+      GLFWwindow * window,
+      unsigned int codepoint
+    );
+
+private: // Constants
+
+  static constexpr float REPLAY_DELTA_TIME = 1.0f / 60.0f;
+
+private: // Members
+
+  using WindowFocusFun = void (*)(GLFWwindow *, int);
+  using CursorEnterFun = void (*)(GLFWwindow *, int);
+  using CursorPosFun   = void (*)(GLFWwindow *, double, double);
+  using MouseButtonFun = void (*)(GLFWwindow *, int, int, int);
+  using ScrollFun      = void (*)(GLFWwindow *, double, double);
+  using KeyFun         = void (*)(GLFWwindow *, int, int, int, int);
+  using CharFun        = void (*)(GLFWwindow *, unsigned int);
+
+  Mode                    m_Mode            = Mode::Off;
+  std::string             m_Path;
+  GLFWwindow *            m_Window          = nullptr;
+  WindowFocusFun          m_PrevWindowFocus = nullptr;
+  CursorEnterFun          m_PrevCursorEnter = nullptr;
+  CursorPosFun            m_PrevCursorPos   = nullptr;
+  MouseButtonFun          m_PrevMouseButton = nullptr;
+  ScrollFun               m_PrevScroll      = nullptr;
+  KeyFun                  m_PrevKey         = nullptr;
+  CharFun                 m_PrevChar        = nullptr;
+
+  // Recording
+  std::ofstream           m_Out;
+  double                  m_StartTime       = 0;
+
+  // Replay
+  std::vector<InputEvent> m_Events;
+  std::size_t             m_Next            = 0;
+  bool                    m_ExitAtEnd       = false;
+  std::chrono::steady_clock::time_point m_LastFrame;
+  std::vector<float>      m_FrameTimes;
+};
@@ -3,12 +3,56 @@
 #include "MainEditWindow.h"
 #include "DrawFigureWindow.h"
 #include "MorphingWindow.h"
+#include "TimelineWindow.h"
+#include "MassMorphWindow.h"
+#include "FrameCostWindow.h"
+#include "FrameCost.h"
 
 #include <exception>
 #include <iostream>
+#include <string>
 
-int main()
+namespace
 {
+
+constexpr const char * USAGE = "Usage: lab [--record <input log> | --replay <input log> [--headless]]";
+
+} // namespace
+
+int main(
+    int    argc,
+    char * argv[]
+  )
+{
+  std::string RecordPath;
+  std::string ReplayPath;
+  bool IsHeadless = false;
+
+  for (int i = 1; i < argc; ++i)
+  {
+    const std::string Arg = argv[i];
+
+    if (Arg == "--record" && i + 1 < argc)
+      RecordPath = argv[++i];
+    else
+    if (Arg == "--replay" && i + 1 < argc)
+      ReplayPath = argv[++i];
+    else
+    if (Arg == "--headless")
+      IsHeadless = true;
+    else
+    {
+      std::cerr << USAGE << std::endl;
+      return 1;
+    }
+  }
+
+  if ((!RecordPath.empty() && !ReplayPath.empty()) || (IsHeadless && ReplayPath.empty()))
+  {
+    std::cerr << USAGE << std::endl;
+    return 1;
+  }
+
   ImGuiVulkanGlfwApplication app;
 
   auto FirstFigureWindow  = std::make_shared<DrawFigureWindow>("Draw first figure", 0xFF00FF00);
@@ -21,9 +65,23 @@ int main()
       FirstFigureWindow,
       SecondFigureWindow
     ));
+  app.AddWindow(std::make_shared<TimelineWindow>(
+      "Timeline",
+      std::vector<std::shared_ptr<DrawFigureWindow>>{ FirstFigureWindow, SecondFigureWindow }
+    ));
+  app.AddWindow(std::make_shared<MassMorphWindow>("Stress scene"));
+
+  if (FrameCost::IsEnabled())
+    app.AddWindow(std::make_shared<FrameCostWindow>("Frame costs"));
 
   try
   {
+    if (!RecordPath.empty())
+      app.RecordInput(RecordPath);
+
+    if (!ReplayPath.empty())
+      app.ReplayInput(ReplayPath, IsHeadless);
+
     app.Run();
   }
   catch (const std::exception & ex)
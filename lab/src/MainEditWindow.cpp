@@ -3,7 +3,7 @@
 #include <imgui.h>
 #include <cmath>
 
-std::string MainEditWindow::GetWindowName() const
+std::string_view MainEditWindow::GetWindowName() const
 {
   return "Edit";
 }
@@ -7,7 +7,7 @@ class MainEditWindow :
 {
 protected: // IWindow
 
-  std::string GetWindowName() const override;
+  std::string_view GetWindowName() const override;
 
   void UpdateFrameData() override;
 
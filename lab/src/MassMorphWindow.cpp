@@ -0,0 +1,80 @@
+#include "MassMorphWindow.h"
+
+#include "MorphingWindow.h"
+#include "ImVecUtils.h"
+
+#include <chrono>
+
+//
+// Construction
+//
+
+MassMorphWindow::MassMorphWindow(
+    const std::string & window_name
+  ) :
+    m_WindowName(window_name)
+{
+  Regenerate();
+}
+
+//
+// IWindow
+//
+
+std::string_view MassMorphWindow::GetWindowName() const
+{
+  return m_WindowName;
+}
+
+void MassMorphWindow::UpdateFrameData()
+{
+  bool NeedRegenerate = false;
+
+  NeedRegenerate |= ImGui::SliderInt("Pairs", &m_PairCount, 1, 50000, "%d", ImGuiSliderFlags_Logarithmic);
+  NeedRegenerate |= ImGui::SliderInt("Points per figure", &m_PointsPerFigure, 4, 256);
+
+  if (NeedRegenerate)
+    Regenerate();
+
+  ImGui::SliderInt("Spline samples", &m_Samples, 0, int(SPLINE_POINTS_PER_SEGMENT));
+  ImGui::Checkbox("Animation", &m_IsAnimationActive);
+
+  ImGui::Text(
+      "Pairs: %d (%d visible), points: %d, vertices: %d",
+      int(m_Scene.GetPairCount()), int(m_Stats.VisiblePairs), int(m_Scene.GetPointCount()), int(m_Stats.Vertices)
+    );
+  ImGui::Text("Geometry: %.2f ms, frame: %.2f ms", m_GeometryTime, 1000.f / ImGui::GetIO().Framerate);
+
+  if (m_IsAnimationActive)
+    m_Scene.Advance(ImGui::GetIO().DeltaTime);
+
+  m_Viewport.Begin();
+
+  const auto Start = std::chrono::steady_clock::now();
+
+  m_Stats = m_Scene.Draw(ImGui::GetWindowDrawList(), m_Viewport.GetOrigin(), m_Viewport.GetZoom(), m_Samples);
+
+  const auto Elapsed = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - Start).count();
+  m_GeometryTime += (Elapsed - m_GeometryTime) * 0.1f;
+
+  m_Viewport.End();
+}
+
+bool MassMorphWindow::IsAnimating() const
+{
+  return m_IsAnimationActive;
+}
+
+//
+// Service
+//
+
+void MassMorphWindow::Regenerate()
+{
+  std::vector<MorphScene::Easing> Easings;
+
+  for (const auto & [Name, Interpolate] : MorphingWindow::INTERPOLATE_METHODS)
+    Easings.push_back(Interpolate);
+
+  m_Scene.Generate(m_PairCount, m_PointsPerFigure, Easings);
+}
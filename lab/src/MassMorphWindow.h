@@ -0,0 +1,46 @@
+#pragma once
+
+#include "IWindow.h"
+#include "MorphScene.h"
+#include "CanvasViewport.h"
+
+#include <string>
+
+//
+// Scaling benchmark for the geometry core: thousands of figure pairs
+// morphing at once, with pair, point and timing counters.
+//
+
+class MassMorphWindow :
+  public IWindow
+{
+public: // Construction
+
+  MassMorphWindow(
+      const std::string & window_name
+    );
+
+protected: // IWindow
+
+  std::string_view GetWindowName() const override;
+
+  void UpdateFrameData() override;
+
+  bool IsAnimating() const override;
+
+private: // Service
+
+  void Regenerate();
+
+private: // Members
+
+  std::string     m_WindowName;
+  MorphScene      m_Scene;
+  CanvasViewport  m_Viewport;
+  int             m_PairCount = 2000;
+  int             m_PointsPerFigure = 32;
+  int             m_Samples = 2;
+  bool            m_IsAnimationActive = true;
+  float           m_GeometryTime = 0; // Milliseconds, smoothed
+  MorphSceneStats m_Stats;
+};
@@ -0,0 +1,247 @@
+#include "MorphScene.h"
+
+#include "ImVecUtils.h"
+
+#include <random>
+#include <numbers>
+
+namespace
+{
+
+float GetTime(
+    const float phase
+  )
+{
+  return phase < 1 ? phase : 2 - phase;
+}
+
+} // namespace
+
+//
+// Interface
+//
+
+void MorphScene::Generate(
+    const std::size_t           pair_count,
+    const std::size_t           points_per_figure,
+    const std::vector<Easing> & easings,
+    const std::uint32_t         seed
+  )
+{
+  m_PointsPerFigure = std::max<std::size_t>(points_per_figure, 3);
+
+  const auto Points = pair_count * m_PointsPerFigure;
+
+  for (auto * Array : { &m_FirstX, &m_FirstY, &m_SecondX, &m_SecondY })
+    Array->resize(Points);
+
+  for (auto * Array : { &m_Phase, &m_Speed, &m_MinX, &m_MinY, &m_MaxX, &m_MaxY })
+    Array->resize(pair_count);
+
+  m_Easing.resize(pair_count);
+
+  std::mt19937 Engine(seed);
+  std::uniform_real_distribution<float> Unit(0, 1);
+
+  const auto Columns = std::max<std::size_t>(1, std::size_t(std::ceil(std::sqrt(double(pair_count)))));
+
+  for (std::size_t Pair = 0; Pair < pair_count; ++Pair)
+  {
+    const auto Center = ImVec2{ (Pair % Columns + 0.5f) * CELL_SIZE, (Pair / Columns + 0.5f) * CELL_SIZE };
+
+    BoundingBox Bounds;
+
+    for (auto [X, Y] : { std::pair{ &m_FirstX, &m_FirstY }, std::pair{ &m_SecondX, &m_SecondY } })
+    {
+      // r(a) = R * (1 + sum of a few random harmonics)
+      float Amplitude[3], Shift[3];
+
+      for (int h = 0; h < 3; ++h)
+      {
+        Amplitude[h] = 0.25f * Unit(Engine);
+        Shift[h] = 2 * std::numbers::pi_v<float> * Unit(Engine);
+      }
+
+      for (std::size_t i = 0; i < m_PointsPerFigure; ++i)
+      {
+        // The last point closes the outline
+        const auto Angle = 2 * std::numbers::pi_v<float> * (i % (m_PointsPerFigure - 1)) / (m_PointsPerFigure - 1);
+
+        float Radius = 1;
+
+        for (int h = 0; h < 3; ++h)
+          Radius += Amplitude[h] * std::cos((h + 2) * Angle + Shift[h]);
+
+        const auto Point = Center + ImVec2{ std::cos(Angle), std::sin(Angle) } * (FIGURE_RADIUS * Radius / 1.75f);
+
+        (*X)[Pair * m_PointsPerFigure + i] = Point.x;
+        (*Y)[Pair * m_PointsPerFigure + i] = Point.y;
+        Bounds.Add(Point);
+      }
+    }
+
+    // Easings may overshoot and splines bulge between points
+    Bounds.Expand(FIGURE_RADIUS * 0.5f);
+
+    m_MinX[Pair] = Bounds.Min.x;
+    m_MinY[Pair] = Bounds.Min.y;
+    m_MaxX[Pair] = Bounds.Max.x;
+    m_MaxY[Pair] = Bounds.Max.y;
+
+    m_Phase[Pair] = 2 * Unit(Engine);
+    m_Speed[Pair] = 0.2f + 0.8f * Unit(Engine);
+    m_Easing[Pair] = easings.empty() ? &LinearInterpolate : easings[Engine() % easings.size()];
+  }
+}
+
+void MorphScene::Advance(
+    const float delta_time
+  )
+{
+  for (std::size_t Pair = 0; Pair < m_Phase.size(); ++Pair)
+    m_Phase[Pair] = std::fmod(m_Phase[Pair] + m_Speed[Pair] * delta_time, 2.f);
+}
+
+MorphSceneStats MorphScene::Draw(
+    ImDrawList *      draw_list,
+    const ImVec2      origin,
+    const float       zoom,
+    const std::size_t samples_per_segment,
+    const float       thickness
+  )
+{
+  MorphSceneStats Stats;
+
+  if (m_PointsPerFigure < 3)
+    return Stats;
+
+  const auto ClipMin = (draw_list->GetClipRectMin() - origin) / zoom;
+  const auto ClipMax = (draw_list->GetClipRectMax() - origin) / zoom;
+
+  m_Visible.clear();
+
+  for (std::size_t Pair = 0; Pair < m_Phase.size(); ++Pair)
+  {
+    if (m_MaxX[Pair] >= ClipMin.x && m_MinX[Pair] <= ClipMax.x &&
+        m_MaxY[Pair] >= ClipMin.y && m_MinY[Pair] <= ClipMax.y)
+      m_Visible.push_back(Pair);
+  }
+
+  // Every pair emits the same number of quads
+  const auto OutlinePoints = (m_PointsPerFigure - 1) * GetSplineSegmentSamples(samples_per_segment);
+  const auto VerticesPerPair = (OutlinePoints - 1) * 4;
+  const auto IndicesPerPair = (OutlinePoints - 1) * 6;
+  const auto PairsPerChunk = std::max<std::size_t>(1, MAX_CHUNK_VERTICES / VerticesPerPair);
+  const auto WhitePixel = ImGui::GetFontTexUvWhitePixel();
+
+  for (std::size_t Begin = 0; Begin < m_Visible.size(); Begin += PairsPerChunk)
+  {
+    const auto Count = std::min(PairsPerChunk, m_Visible.size() - Begin);
+
+    draw_list->PrimReserve(int(Count * IndicesPerPair), int(Count * VerticesPerPair));
+
+    auto * Vertices = draw_list->_VtxWritePtr;
+    auto * Indices = draw_list->_IdxWritePtr;
+    const auto BaseIndex = draw_list->_VtxCurrentIdx;
+
+    ThreadPool::Instance().ParallelFor(0, Count, PARALLEL_PAIR_GRAIN, [&](const std::size_t begin, const std::size_t end)
+    {
+      std::vector<ImVec2> Morphed, Outline;
+
+      for (auto k = begin; k < end; ++k)
+      {
+        DrawPair(
+            m_Visible[Begin + k],
+            origin, zoom, samples_per_segment, thickness, WhitePixel,
+            Morphed, Outline,
+            Vertices + k * VerticesPerPair,
+            Indices + k * IndicesPerPair,
+            std::uint32_t(BaseIndex + k * VerticesPerPair)
+          );
+      }
+    });
+
+    draw_list->_VtxWritePtr += Count * VerticesPerPair;
+    draw_list->_IdxWritePtr += Count * IndicesPerPair;
+    draw_list->_VtxCurrentIdx += std::uint32_t(Count * VerticesPerPair);
+  }
+
+  Stats.VisiblePairs = m_Visible.size();
+  Stats.Vertices = m_Visible.size() * VerticesPerPair;
+  return Stats;
+}
+
+std::size_t MorphScene::GetPairCount() const
+{
+  return m_Phase.size();
+}
+
+std::size_t MorphScene::GetPointCount() const
+{
+  return m_FirstX.size() + m_SecondX.size();
+}
+
+//
+// Service
+//
+
+void MorphScene::DrawPair(
+    const std::size_t     pair,
+    const ImVec2          origin,
+    const float           zoom,
+    const std::size_t     samples_per_segment,
+    const float           thickness,
+    const ImVec2          uv,
+    std::vector<ImVec2> & morphed,
+    std::vector<ImVec2> & outline,
+    ImDrawVert *          vertices,
+    ImDrawIdx *           indices,
+    const std::uint32_t   base_index
+  ) const
+{
+  const auto Offset = pair * m_PointsPerFigure;
+  const FigureView First(m_FirstX.data() + Offset, m_FirstY.data() + Offset, m_PointsPerFigure);
+  const FigureView Second(m_SecondX.data() + Offset, m_SecondY.data() + Offset, m_PointsPerFigure);
+
+  const auto t = GetTime(m_Phase[pair]);
+  const auto Weight = m_Easing[pair](ImVec2{ 0, 0 }, ImVec2{ 1, 0 }, t).x;
+
+  morphed.resize(m_PointsPerFigure);
+
+  for (std::size_t i = 0; i < m_PointsPerFigure; ++i)
+    morphed[i] = origin + (First[i] + (Second[i] - First[i]) * Weight) * zoom;
+
+  const auto Samples = GetSplineSegmentSamples(samples_per_segment);
+  outline.resize((m_PointsPerFigure - 1) * Samples);
+
+  for (std::size_t i = 0; i + 1 < m_PointsPerFigure; ++i)
+    TessellateSplineSegment(morphed, i, samples_per_segment, outline.data() + i * Samples);
+
+  const auto Color = IM_COL32(255 * t, 255 * (1 - t), 0, 255);
+  const auto HalfWidth = thickness * 0.5f;
+
+  for (std::size_t i = 0; i + 1 < outline.size(); ++i)
+  {
+    const auto a = outline[i];
+    const auto b = outline[i + 1];
+    const auto d = b - a;
+    const auto Length = std::sqrt(d * d);
+    const auto n = Length > 0 ? ImVec2{ -d.y, d.x } * (HalfWidth / Length) : ImVec2{ 0, 0 };
+
+    vertices[0] = { a + n, uv, Color };
+    vertices[1] = { b + n, uv, Color };
+    vertices[2] = { b - n, uv, Color };
+    vertices[3] = { a - n, uv, Color };
+
+    const auto Base = ImDrawIdx(base_index + i * 4);
+    indices[0] = Base;
+    indices[1] = ImDrawIdx(Base + 1);
+    indices[2] = ImDrawIdx(Base + 2);
+    indices[3] = Base;
+    indices[4] = ImDrawIdx(Base + 2);
+    indices[5] = ImDrawIdx(Base + 3);
+
+    vertices += 4;
+    indices += 6;
+  }
+}
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <imgui.h>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+//
+// Stress scene of many independently animated figure pairs.
+//
+// Points are kept in a packed SoA store (separate x/y arrays, a fixed
+// number of points per figure), per-pair state in parallel arrays. Drawing
+// culls the pairs against the clip rect, then morphs, tessellates and
+// writes line quads for the visible ones on the thread pool straight into
+// reserved draw list memory, in chunks that fit 16-bit indices.
+//
+
+struct MorphSceneStats
+{
+  std::size_t VisiblePairs = 0;
+  std::size_t Vertices     = 0;
+};
+
+class MorphScene
+{
+public: // Types
+
+  using Easing = ImVec2(*)(ImVec2, ImVec2, float);
+
+public: // Interface
+
+  // Random closed blobs on a grid, each pair gets a random easing from
+  // `easings`, phase and speed
+  void Generate(
+      const std::size_t           pair_count,
+      const std::size_t           points_per_figure,
+      const std::vector<Easing> & easings,
+      const std::uint32_t         seed = 0
+    );
+
+  void Advance(
+      const float delta_time
+    );
+
+  MorphSceneStats Draw(
+      ImDrawList *      draw_list,
+      const ImVec2      origin,
+      const float       zoom,
+      const std::size_t samples_per_segment,
+      const float       thickness = 1
+    );
+
+  std::size_t GetPairCount() const;
+
+  std::size_t GetPointCount() const;
+
+private: // Service
+
+  void DrawPair(
+      const std::size_t     pair,
+      const ImVec2          origin,
+      const float           zoom,
+      const std::size_t     samples_per_segment,
+      const float           thickness,
+      const ImVec2          uv,
+      std::vector<ImVec2> & morphed,
+      std::vector<ImVec2> & outline,
+      ImDrawVert *          vertices,
+      ImDrawIdx *           indices,
+      const std::uint32_t   base_index
+    ) const;
+
+private: // Constants
+
+  static constexpr float       CELL_SIZE           = 120.f;
+  static constexpr float       FIGURE_RADIUS       = 45.f;
+  static constexpr std::size_t MAX_CHUNK_VERTICES  = 65532;
+  static constexpr std::size_t PARALLEL_PAIR_GRAIN = 16;
+
+private: // Members
+
+  std::size_t         m_PointsPerFigure = 0;
+
+  // Figure points, pair i occupies [i * m_PointsPerFigure, (i + 1) * m_PointsPerFigure)
+  std::vector<float>  m_FirstX;
+  std::vector<float>  m_FirstY;
+  std::vector<float>  m_SecondX;
+  std::vector<float>  m_SecondY;
+
+  // Per-pair state
+  std::vector<float>  m_Phase; // [0, 2), morphs forth and back
+  std::vector<float>  m_Speed;
+  std::vector<Easing> m_Easing;
+  std::vector<float>  m_MinX;
+  std::vector<float>  m_MinY;
+  std::vector<float>  m_MaxX;
+  std::vector<float>  m_MaxY;
+
+  std::vector<std::size_t> m_Visible;
+};
@@ -0,0 +1,318 @@
+#include "MorphWorker.h"
+
+#include "ImVecUtils.h"
+
+//
+// Construction / Destruction
+//
+
+MorphWorker::MorphWorker()
+{
+  m_Thread = std::thread(&MorphWorker::ThreadFunc, this);
+}
+
+MorphWorker::~MorphWorker()
+{
+  {
+    std::lock_guard Lock(m_Mutex);
+    m_Stop = true;
+  }
+
+  m_Condition.notify_one();
+  m_Thread.join();
+}
+
+//
+// Interface
+//
+
+void MorphWorker::Submit(
+    const MorphRequest & request
+  )
+{
+  if (request == m_LastSubmitted)
+    return;
+
+  m_LastSubmitted = request;
+  ++m_SubmittedVersion;
+
+  {
+    std::lock_guard Lock(m_Mutex);
+    m_Pending = request;
+    m_PendingVersion = m_SubmittedVersion;
+  }
+
+  m_Condition.notify_one();
+}
+
+const MorphResult & MorphWorker::GetResult()
+{
+  m_Results.Acquire();
+
+  const auto & Result = m_Results.GetReadBuffer();
+  m_AcquiredVersion = Result.RequestVersion;
+
+  return Result;
+}
+
+bool MorphWorker::IsBusy() const
+{
+  return m_AcquiredVersion != m_SubmittedVersion;
+}
+
+//
+// Service
+//
+
+void MorphWorker::ThreadFunc()
+{
+  while (true)
+  {
+    MorphRequest Request;
+    std::uint64_t Version;
+
+    {
+      std::unique_lock Lock(m_Mutex);
+      m_Condition.wait(Lock, [this] { return m_Stop || m_Pending.has_value(); });
+
+      if (m_Stop)
+        return;
+
+      Request = std::move(*m_Pending);
+      Version = m_PendingVersion;
+      m_Pending.reset();
+    }
+
+    auto & Result = m_Results.GetWriteBuffer();
+
+    Process(Request, Result);
+    Result.RequestVersion = Version;
+    m_Results.Publish();
+  }
+}
+
+void MorphWorker::Process(
+    const MorphRequest & request,
+    MorphResult &        result
+  )
+{
+  if (request.First != m_CachedFirst
+   || request.Second != m_CachedSecond
+   || request.Correspondence != m_CachedCorrespondence
+   || request.AlignClosed != m_CachedAlignClosed
+   || request.AlignRotation != m_CachedAlignRotation)
+  {
+    m_CachedFirst = request.First;
+    m_CachedSecond = request.Second;
+    m_CachedCorrespondence = request.Correspondence;
+    m_CachedAlignClosed = request.AlignClosed;
+    m_CachedAlignRotation = request.AlignRotation;
+
+    // A drawn figure's history chunks are gathered here, off the UI thread
+    auto First = m_CachedFirst.GetPoints();
+    auto Second = m_CachedSecond.GetPoints();
+
+    m_Alignment.reset();
+
+    if (request.AlignClosed)
+      m_Alignment = AlignClosedFigures(First, Second, request.AlignRotation);
+
+    // Aligned figures already match point by point, DTW may still refine it
+    if (m_Alignment)
+    {
+      First = m_Alignment->First;
+      Second = m_Alignment->Second;
+    }
+
+    MatchFiguresInto(First, Second, request.Correspondence, m_FilledFirst, m_FilledSecond);
+
+    m_Lod.Build(m_FilledFirst, m_FilledSecond);
+    m_Fourier.Reset();
+    m_SplineLevel = NO_SPLINE_LEVEL;
+    m_MorphLevel = NO_SPLINE_LEVEL;
+  }
+
+  if (request.Mode == MorphMode::Fourier && m_Fourier.IsEmpty())
+    BuildFourier();
+
+  result.Time = request.Time;
+
+  // Easing that overshoots the [0, 1] range scales the deviation of the levels
+  const float Eased = request.Interpolate ? request.Interpolate(ImVec2{ 0, 0 }, ImVec2{ 1, 0 }, request.Time).x : 0;
+  const auto * Level = m_Lod.Select(request.Zoom * (std::abs(1 - Eased) + std::abs(Eased)));
+
+  const FigureView First = Level ? FigureView(Level->First) : FigureView(m_FilledFirst);
+  const FigureView Second = Level ? FigureView(Level->Second) : FigureView(m_FilledSecond);
+
+  const auto LevelIndex = Level ? Level - m_Lod.GetLevels().data() : FULL_SPLINE_LEVEL;
+
+  result.MorphSpline.Clear();
+  result.MorphFirst.reset();
+  result.MorphSecond.reset();
+  result.Weight = Eased;
+
+  // Every easing is a linear blend at the eased weight, which is all the
+  // kernel evaluates, so only the matched points have to be handed over
+  const bool UseGpuMorph = request.GpuMorph
+                        && request.Interpolate
+                        && request.Mode == MorphMode::Points
+                        && !m_Alignment
+                        && First.Size() == Second.Size()
+                        && First.Size() >= 3;
+
+  if (UseGpuMorph)
+  {
+    if (m_MorphLevel != LevelIndex)
+    {
+      m_MorphFirst = std::make_shared<const FigureBuffer>(First);
+      m_MorphSecond = std::make_shared<const FigureBuffer>(Second);
+      m_MorphLevel = LevelIndex;
+      ++m_MorphPointsVersion;
+    }
+
+    result.MorphFirst = m_MorphFirst;
+    result.MorphSecond = m_MorphSecond;
+  }
+  else
+  if (request.Interpolate)
+  {
+    auto & Morphed = m_Morphed;
+
+    if (m_Alignment)
+    {
+      // The shape is morphed in the first figure's frame, the pose separately
+      const auto & Alignment = *m_Alignment;
+      const auto Center = LinearInterpolate(Alignment.FirstCenter, Alignment.SecondCenter, Eased);
+      const auto Factor = Alignment.GetFactor(Eased);
+      const auto Inverse = ComplexInverse(Alignment.Factor);
+
+      if (request.Mode == MorphMode::Fourier)
+      {
+        Morphed.Assign(m_Fourier.Get(Eased, request.Coefficients));
+
+        for (std::size_t i = 0; i < Morphed.Size(); ++i)
+          Morphed.Set(i, Center + ComplexMultiply(Factor, Morphed[i]));
+      }
+      else
+      {
+        MorphInto(First, Second, request.Time, [&](ImVec2 a, ImVec2 b, float t)
+        {
+          const auto Shape = request.Interpolate(a - Alignment.FirstCenter, ComplexMultiply(Inverse, b - Alignment.SecondCenter), t);
+          return Center + ComplexMultiply(Factor, Shape);
+        }, Morphed);
+      }
+    }
+    else
+    if (request.Mode == MorphMode::Fourier)
+    {
+      Morphed.Assign(m_Fourier.Get(Eased, request.Coefficients));
+    }
+    else
+    {
+      // Every easing is a linear blend at the eased weight
+      MorphLinearInto(First, Second, Eased, Morphed);
+    }
+
+    if (Morphed.Size() >= 2)
+      GetSplineInto(Morphed, SPLINE_POINTS_PER_SEGMENT, result.MorphSpline);
+  }
+
+  result.FirstSpline.Clear();
+  result.SecondSpline.Clear();
+  result.FirstPoints.Clear();
+  result.SecondPoints.Clear();
+  result.OnionSkin.Clear();
+  result.OnionSkinTimes.clear();
+  result.OnionSkinError.reset();
+
+  // Onion skin shows the plain per-point morph
+  const bool NeedOnionSkin = request.OnionSkinFrames >= 2
+                          && request.Interpolate
+                          && request.Mode == MorphMode::Points
+                          && !m_Alignment;
+
+  if ((request.NeedTransitions || NeedOnionSkin) && First.Size() == Second.Size())
+  {
+    if (m_SplineLevel != LevelIndex)
+    {
+      TaskGroup Group;
+      Group.Run([&] { GetSplineInto(First, SPLINE_POINTS_PER_SEGMENT, m_FirstSpline); });
+      GetSplineInto(Second, SPLINE_POINTS_PER_SEGMENT, m_SecondSpline);
+      Group.Wait();
+
+      m_SplineLevel = LevelIndex;
+      ++m_SplineVersion;
+    }
+  }
+
+  if (NeedOnionSkin && First.Size() == Second.Size())
+  {
+    // The easings only reshape the weight of a linear blend, and matched
+    // figures tessellate to matched outlines, so every frame is a blend of
+    // the two cached splines: no per-frame interpolation setup or spline
+    // evaluation. The centripetal knots depend on the point distances, so
+    // this only approximates the spline of the blended figure, the check
+    // measures by how much.
+    std::vector<float> Weights;
+
+    for (std::size_t k = 0; k < request.OnionSkinFrames; ++k)
+    {
+      const auto t = float(k) / (request.OnionSkinFrames - 1);
+      result.OnionSkinTimes.push_back(t);
+      Weights.push_back(request.Interpolate(ImVec2{ 0, 0 }, ImVec2{ 1, 0 }, t).x);
+    }
+
+    MorphBatch(m_FirstSpline, m_SecondSpline, Weights, result.OnionSkin);
+
+    if (request.CheckOnionSkin)
+    {
+      const auto Length = m_FirstSpline.Size();
+      float Error = 0;
+
+      for (std::size_t k = 0; k < result.OnionSkinTimes.size(); ++k)
+      {
+        const auto Exact = GetSpline(Morph(First, Second, result.OnionSkinTimes[k], request.Interpolate), SPLINE_POINTS_PER_SEGMENT);
+
+        for (std::size_t i = 0; i < std::min(Length, Exact.size()); ++i)
+          Error = std::max(Error, ImVecDistance(result.OnionSkin[k * Length + i], Exact[i]));
+      }
+
+      result.OnionSkinError = Error;
+    }
+  }
+
+  if (request.NeedTransitions && First.Size() == Second.Size())
+  {
+    result.FirstPoints.Assign(First);
+    result.SecondPoints.Assign(Second);
+    result.FirstSpline = m_FirstSpline;
+    result.SecondSpline = m_SecondSpline;
+  }
+
+  result.SplineVersion = m_SplineVersion;
+  result.MorphPointsVersion = m_MorphPointsVersion;
+}
+
+void MorphWorker::BuildFourier()
+{
+  if (!m_Alignment)
+  {
+    m_Fourier.Build(m_FilledFirst, m_FilledSecond, false);
+    return;
+  }
+
+  const auto & Alignment = *m_Alignment;
+  const auto Inverse = ComplexInverse(Alignment.Factor);
+
+  FigureBuffer First, Second;
+  First.Resize(m_FilledFirst.Size());
+  Second.Resize(m_FilledSecond.Size());
+
+  for (std::size_t i = 0; i < m_FilledFirst.Size(); ++i)
+    First.Set(i, m_FilledFirst[i] - Alignment.FirstCenter);
+
+  for (std::size_t i = 0; i < m_FilledSecond.Size(); ++i)
+    Second.Set(i, ComplexMultiply(Inverse, m_FilledSecond[i] - Alignment.SecondCenter));
+
+  m_Fourier.Build(First, Second, true);
+}
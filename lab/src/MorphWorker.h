@@ -0,0 +1,174 @@
+#pragma once
+
+#include "TripleBuffer.h"
+#include "FigureLod.h"
+#include "Correspondence.h"
+#include "FigureAlignment.h"
+#include "FourierMorph.h"
+#include "FigureBuffer.h"
+#include "FigureSnapshot.h"
+
+#include <imgui.h>
+#include <vector>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <optional>
+#include <cstdint>
+
+//
+// Runs the morph geometry (correspondence, interpolation, tessellation)
+// off the UI thread. The UI thread submits the latest parameters, the
+// worker publishes finished polylines through a triple buffer, so drawing
+// never waits for geometry and always sees a complete result.
+//
+// The geometry stays in FigureBuffers from the matched figures to the
+// published outlines, ImVec2 points only appear where they are drawn or
+// uploaded.
+//
+
+enum class MorphMode
+{
+  Points,  // Ease every pair of matched points
+  Fourier, // Ease the Fourier descriptors of the figures
+};
+
+struct MorphRequest
+{
+  FigureSnapshot       First;
+  FigureSnapshot       Second;
+  float                Time            = 0;
+  float                Zoom            = 1;
+  bool                 NeedTransitions = false;
+  CorrespondenceMethod Correspondence  = CorrespondenceMethod::Index;
+  bool                 AlignClosed     = false;
+  bool                 AlignRotation   = true;
+  MorphMode            Mode            = MorphMode::Points;
+  std::size_t          Coefficients    = 32;
+  std::size_t          OnionSkinFrames = 0;
+  bool                 CheckOnionSkin  = false; // Measure OnionSkinError
+  bool                 GpuMorph        = false; // Leave the per-point morph to GpuMorphKernel
+
+  ImVec2(*Interpolate)(ImVec2, ImVec2, float) = nullptr;
+
+  bool operator==(const MorphRequest & other) const = default;
+};
+
+// Immutable figure shared between the worker and the UI thread
+using BufferSnapshot = std::shared_ptr<const FigureBuffer>;
+
+struct MorphResult
+{
+  float               Time = 0;
+  FigureBuffer        MorphSpline;
+  FigureBuffer        FirstSpline;
+  FigureBuffer        SecondSpline;
+  FigureBuffer        FirstPoints;
+  FigureBuffer        SecondPoints;
+
+  // Changes whenever FirstSpline and SecondSpline are rebuilt
+  std::uint64_t       SplineVersion = 0;
+
+  // Of the request this result answers, counted by Submit()
+  std::uint64_t       RequestVersion = 0;
+
+  // Set instead of MorphSpline when the request asked for the GPU morph:
+  // the matched points of the selected level and the eased weight to blend
+  // them at, MorphPointsVersion changes whenever the points do
+  BufferSnapshot      MorphFirst;
+  BufferSnapshot      MorphSecond;
+  std::uint64_t       MorphPointsVersion = 0;
+  float               Weight = 0;
+
+  // OnionSkinTimes.size() outlines of equal length, one after another
+  FigureBuffer        OnionSkin;
+  std::vector<float>  OnionSkinTimes;
+
+  // Largest distance in pixels between an onion skin outline and the
+  // spline of the figure morphed at its time, when requested
+  std::optional<float> OnionSkinError;
+};
+
+class MorphWorker
+{
+public: // Construction / Destruction
+
+  MorphWorker();
+
+  ~MorphWorker();
+
+  MorphWorker(const MorphWorker &) = delete;
+  MorphWorker & operator=(const MorphWorker &) = delete;
+
+public: // Interface
+
+  // Replaces any request the worker has not started yet
+  void Submit(
+      const MorphRequest & request
+    );
+
+  // Latest complete result, only valid on the submitting (UI) thread
+  const MorphResult & GetResult();
+
+  // True until the result of the latest request was acquired. Results
+  // arrive without an input event, so the window keeps frames coming
+  // meanwhile.
+  bool IsBusy() const;
+
+private: // Service
+
+  void ThreadFunc();
+
+  void Process(
+      const MorphRequest & request,
+      MorphResult &        result
+    );
+
+  // Descriptors of the matched figures, in the first figure's frame when
+  // they are aligned
+  void BuildFourier();
+
+private: // Constants
+
+  // Values of m_SplineLevel and m_MorphLevel besides the LOD level indices
+  static constexpr std::ptrdiff_t NO_SPLINE_LEVEL   = -2;
+  static constexpr std::ptrdiff_t FULL_SPLINE_LEVEL = -1;
+
+private: // Members
+
+  std::mutex                     m_Mutex;
+  std::condition_variable        m_Condition;
+  std::optional<MorphRequest>    m_Pending;
+  std::uint64_t                  m_PendingVersion = 0;
+  MorphRequest                   m_LastSubmitted;
+  std::uint64_t                  m_SubmittedVersion = 0;
+  bool                           m_Stop = false;
+
+  TripleBuffer<MorphResult>      m_Results;
+  std::uint64_t                  m_AcquiredVersion = 0;
+
+  // Worker thread only: correspondence cache, rebuilt when a figure
+  // or an option changes
+  FigureSnapshot                 m_CachedFirst;
+  FigureSnapshot                 m_CachedSecond;
+  CorrespondenceMethod           m_CachedCorrespondence = CorrespondenceMethod::Index;
+  bool                           m_CachedAlignClosed = false;
+  bool                           m_CachedAlignRotation = true;
+  std::optional<FigureAlignment> m_Alignment;
+  FourierMorph                   m_Fourier;
+  FigureBuffer                   m_FilledFirst;
+  FigureBuffer                   m_FilledSecond;
+  FigurePairLod                  m_Lod;
+  FigureBuffer                   m_FirstSpline;
+  FigureBuffer                   m_SecondSpline;
+  std::ptrdiff_t                 m_SplineLevel = NO_SPLINE_LEVEL;
+  std::uint64_t                  m_SplineVersion = 0;
+  BufferSnapshot                 m_MorphFirst;
+  BufferSnapshot                 m_MorphSecond;
+  std::ptrdiff_t                 m_MorphLevel = NO_SPLINE_LEVEL;
+  std::uint64_t                  m_MorphPointsVersion = 0;
+  FigureBuffer                   m_Morphed;
+
+  std::thread                    m_Thread;
+};
@@ -15,6 +15,11 @@ const std::vector<std::pair<std::string, ImVec2(*)(ImVec2, ImVec2, float)>> Morp
     { "InOutBounce", &InOutBounceInterpolate },
   };
 
+const std::vector<std::pair<std::string, CorrespondenceMethod>> MorphingWindow::CORRESPONDENCE_METHODS {
+    { "By index", CorrespondenceMethod::Index },
+    { "DTW",      CorrespondenceMethod::Dtw   },
+  };
+
 //
 // Construction
 //
@@ -36,7 +41,7 @@ MorphingWindow::MorphingWindow(
 // IWindow
 //
 
-std::string MorphingWindow::GetWindowName() const
+std::string_view MorphingWindow::GetWindowName() const
 {
   return m_WindowName;
 }
@@ -48,6 +53,19 @@ void MorphingWindow::UpdateFrameData()
 
   ImGui::Checkbox("Animation", &m_IsAnimationActive);
   ImGui::Checkbox("Draw transitions", &m_NeedDrawTransitions);
+  ImGui::Checkbox("Onion skin", &m_OnionSkin);
+
+  if (m_OnionSkin)
+  {
+    ImGui::SameLine();
+    ImGui::SliderInt("Frames", &m_OnionSkinFrames, 2, 64);
+    ImGui::Checkbox("Compare with per-frame splines", &m_CheckOnionSkin);
+
+    // The frames blend the two source splines instead of tessellating
+    // every blended figure, this is how far apart the two get
+    if (m_CheckOnionSkin && m_OnionSkinError)
+      ImGui::Text("Onion skin vs per-frame splines: max error %g px", double(*m_OnionSkinError));
+  }
 
   if (ImGui::BeginCombo("##combo", m_CurrentMethod->first.c_str()))
   {
@@ -64,6 +82,58 @@ void MorphingWindow::UpdateFrameData()
     ImGui::EndCombo();
   }
 
+  // Dynamic time warping pairs similar features instead of equal indices
+  for (const auto & [Name, Method] : CORRESPONDENCE_METHODS)
+  {
+    if (ImGui::RadioButton(Name.c_str(), m_Correspondence == Method))
+      m_Correspondence = Method;
+
+    ImGui::SameLine();
+  }
+
+  ImGui::TextUnformatted("Correspondence");
+
+  // Closed figures only: match start points (and rotation) before morphing
+  ImGui::Checkbox("Align closed figures", &m_AlignClosed);
+  ImGui::SameLine();
+  ImGui::Checkbox("With rotation", &m_AlignRotation);
+
+  // Fewer coefficients give smoother shapes and a smaller inverse FFT
+  if (ImGui::RadioButton("Per point", m_Mode == MorphMode::Points))
+    m_Mode = MorphMode::Points;
+
+  ImGui::SameLine();
+
+  if (ImGui::RadioButton("Fourier", m_Mode == MorphMode::Fourier))
+    m_Mode = MorphMode::Fourier;
+
+  if (m_Mode == MorphMode::Fourier)
+    ImGui::SliderInt("Coefficients", &m_Coefficients, 1, 4096, "%d", ImGuiSliderFlags_Logarithmic);
+
+  // Morph and tessellate on the GPU, straight into the vertex buffer
+  const bool CanUseGpuMorph = GpuMorphKernel::Instance().IsAvailable() && GpuFigureRenderer::Instance().CanDraw();
+
+  if (CanUseGpuMorph)
+  {
+    ImGui::Checkbox("GPU morph", &m_GpuMorph);
+
+    if (m_GpuMorph)
+    {
+      ImGui::SameLine();
+      ImGui::Checkbox("Compare with CPU", &m_CompareGpuMorph);
+    }
+
+    // Bit-identical wherever the driver rounds division and square roots
+    // correctly, as the CPU does
+    if (m_GpuMorph && m_CompareGpuMorph)
+    {
+      ImGui::Text(
+          "GPU vs CPU: %d of %d points identical, max %u ulp, max error %g",
+          int(m_Comparison.Identical), int(m_Comparison.Count), unsigned(m_Comparison.MaxUlps), double(m_Comparison.MaxError)
+        );
+    }
+  }
+
   if (m_IsAnimationActive)
   {
     const float Next = m_Parameter + ImGui::GetIO().DeltaTime * m_Delta;
@@ -85,38 +155,110 @@ void MorphingWindow::UpdateFrameData()
     }
   }
 
-  ImGui::BeginChild("Viewport", ImVec2(-1, -1), true);
+  m_Viewport.Begin();
 
-  const auto CursorPos = ImGui::GetCursorScreenPos();
+  m_Worker.Submit(MorphRequest{
+      m_FirstFigure->GetSnapshot(),
+      m_SecondFigure->GetSnapshot(),
+      m_Parameter,
+      m_Viewport.GetZoom(),
+      m_NeedDrawTransitions,
+      m_Correspondence,
+      m_AlignClosed,
+      m_AlignRotation,
+      m_Mode,
+      std::size_t(m_Coefficients),
+      m_OnionSkin ? std::size_t(m_OnionSkinFrames) : 0,
+      m_OnionSkin && m_CheckOnionSkin,
+      m_GpuMorph && CanUseGpuMorph,
+      m_CurrentMethod->second
+    });
 
-  auto FirstFigure = m_FirstFigure->GetPoints();
-  auto SecondFigure = m_SecondFigure->GetPoints();
-  //auto FirstFigure = GetSpline(m_FirstFigure->GetPoints(), 10);
-  //auto SecondFigure = GetSpline(m_SecondFigure->GetPoints(), 10);
+  const auto Origin = m_Viewport.GetOrigin();
+  const auto Zoom = m_Viewport.GetZoom();
 
-  if (FirstFigure.size() > 2 && SecondFigure.size() > 2)
-    std::tie(FirstFigure, SecondFigure) = FillMissingPoints(FirstFigure, SecondFigure);
+  // Only draw calls here, the geometry comes from the worker thread
+  const auto & Result = m_Worker.GetResult();
 
-  if (m_NeedDrawTransitions && FirstFigure.size() == SecondFigure.size())
+  m_OnionSkinError = Result.OnionSkinError;
+
+  if (m_NeedDrawTransitions && !Result.FirstPoints.Empty())
   {
-    DrawFigure(FirstFigure, CursorPos, 0x8000FF00, 3);
+    if (m_GpuSplineVersion != Result.SplineVersion)
+    {
+      m_FirstGpuSpline.Upload(Result.FirstSpline);
+      m_SecondGpuSpline.Upload(Result.SecondSpline);
+      m_GpuSplineVersion = Result.SplineVersion;
+    }
+
+    if (!m_FirstGpuSpline.Draw(Origin, Zoom, 0x8000FF00, 3))
+      DrawCurve(Result.FirstSpline, Origin, 0x8000FF00, 3, Zoom);
 
-    for (int i = 0; i < FirstFigure.size(); ++i)
+    for (std::size_t i = 0; i < Result.FirstPoints.Size(); ++i)
     {
       ImGui::GetWindowDrawList()->AddLine(
-        CursorPos + FirstFigure[i],
-        CursorPos + SecondFigure[i],
+        m_Viewport.ToScreen(Result.FirstPoints[i]),
+        m_Viewport.ToScreen(Result.SecondPoints[i]),
         0x80808080, 1
       );
     }
 
-    DrawFigure(SecondFigure, CursorPos, 0x800000FF, 3);
+    if (!m_SecondGpuSpline.Draw(Origin, Zoom, 0x800000FF, 3))
+      DrawCurve(Result.SecondSpline, Origin, 0x800000FF, 3, Zoom);
   }
 
-  DrawFigure(
-      Morph(FirstFigure, SecondFigure, m_Parameter, m_CurrentMethod->second),
-      CursorPos, IM_COL32(255 * m_Parameter, 255 * (1 - m_Parameter), 0, 255), 3
-    );
+  if (m_OnionSkin && !Result.OnionSkinTimes.empty())
+  {
+    const auto Length = Result.OnionSkin.Size() / Result.OnionSkinTimes.size();
+
+    for (std::size_t k = 0; k < Result.OnionSkinTimes.size(); ++k)
+    {
+      // Frames fade out with their distance from the current time
+      const auto t = Result.OnionSkinTimes[k];
+      const auto Alpha = 160 * (1 - std::abs(t - Result.Time)) + 20;
 
-  ImGui::EndChild();
+      DrawCurve(
+          FigureView(Result.OnionSkin.X() + k * Length, Result.OnionSkin.Y() + k * Length, Length),
+          Origin, IM_COL32(255 * t, 255 * (1 - t), 0, Alpha), 1, Zoom
+        );
+    }
+  }
+
+  const auto MorphColor = IM_COL32(255 * Result.Time, 255 * (1 - Result.Time), 0, 255);
+
+  if (Result.MorphFirst)
+  {
+    if (m_GpuMorphVersion != Result.MorphPointsVersion)
+    {
+      m_GpuMorphKernel.Upload(*Result.MorphFirst, *Result.MorphSecond);
+      m_GpuMorphVersion = Result.MorphPointsVersion;
+    }
+
+    // The CPU reference is the exact computation the worker does without
+    // the GPU: every easing is a linear blend at the eased weight
+    const auto GetCpuMorph = [&]
+    {
+      auto & Arena = FrameArena::GetResource();
+      return GetSpline(Morph(*Result.MorphFirst, *Result.MorphSecond, Result.Weight, &LinearInterpolate, Arena), SPLINE_POINTS_PER_SEGMENT, Arena);
+    };
+
+    if (m_CompareGpuMorph)
+      m_Comparison = CompareOutlines(m_GpuMorphKernel.ReadBack(Result.Weight), GetCpuMorph());
+
+    // The result may still be one for the GPU after it became unusable
+    if (!m_GpuMorphKernel.Draw(Result.Weight, Origin, Zoom, MorphColor, 3))
+      DrawCurve(GetCpuMorph(), Origin, MorphColor, 3, Zoom);
+  }
+  else
+  {
+    DrawCurve(Result.MorphSpline, Origin, MorphColor, 3, Zoom);
+  }
+
+  m_Viewport.End();
+}
+
+bool MorphingWindow::IsAnimating() const
+{
+  // Keeps frames coming until the worker's result is drawn
+  return m_IsAnimationActive || m_Worker.IsBusy();
 }
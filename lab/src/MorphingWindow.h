@@ -2,11 +2,17 @@
 
 #include "IWindow.h"
 #include "DrawFigureWindow.h"
+#include "MorphWorker.h"
+#include "CanvasViewport.h"
+#include "GpuFigureRenderer.h"
+#include "GpuMorphKernel.h"
 
 #include <imgui.h>
 #include <vector>
+#include <optional>
 #include <memory>
 #include <map>
+#include <cstdint>
 
 class MorphingWindow :
   public IWindow
@@ -19,15 +25,18 @@ public: // Construction
       const std::shared_ptr<DrawFigureWindow> & second_figure
     );
 
+public: // Constants
+
+  static const std::vector<std::pair<std::string, ImVec2(*)(ImVec2, ImVec2, float)>> INTERPOLATE_METHODS;
+  static const std::vector<std::pair<std::string, CorrespondenceMethod>>         CORRESPONDENCE_METHODS;
+
 protected: // IWindow
 
-  std::string GetWindowName() const override;
+  std::string_view GetWindowName() const override;
 
   void UpdateFrameData() override;
 
-private: // Constants
-
-  static const std::vector<std::pair<std::string, ImVec2(*)(ImVec2, ImVec2, float)>> INTERPOLATE_METHODS;
+  bool IsAnimating() const override;
 
 private: // Members
 
@@ -38,7 +47,35 @@ private: // Members
   bool                              m_IsAnimationActive = false;
   bool                              m_NeedDrawTransitions = false;
   float                             m_Delta = 0.35f;
+  CorrespondenceMethod              m_Correspondence = CorrespondenceMethod::Index;
+  bool                              m_AlignClosed = false;
+  bool                              m_AlignRotation = true;
+  MorphMode                         m_Mode = MorphMode::Points;
+  int                               m_Coefficients = 32;
+  bool                              m_OnionSkin = false;
+  int                               m_OnionSkinFrames = 8;
+  bool                              m_CheckOnionSkin = false;
+  bool                              m_GpuMorph = false;
+  bool                              m_CompareGpuMorph = false;
 
   const std::pair<std::string, ImVec2(*)(ImVec2, ImVec2, float)> * m_CurrentMethod = nullptr;
+
+  CanvasViewport m_Viewport;
+  MorphWorker    m_Worker;
+
+  // Source outlines only change with SplineVersion, the morph itself
+  // is streamed every frame
+  GpuFigure      m_FirstGpuSpline;
+  GpuFigure      m_SecondGpuSpline;
+  std::uint64_t  m_GpuSplineVersion = 0;
+
+  // Per-point morph evaluated by the compute kernel, compared against the
+  // CPU kernels on demand
+  GpuMorph         m_GpuMorphKernel;
+  std::uint64_t    m_GpuMorphVersion = 0;
+  KernelComparison m_Comparison;
+
+  // Of the latest onion skin, see MorphResult::OnionSkinError
+  std::optional<float> m_OnionSkinError;
 };
 
@@ -0,0 +1,123 @@
+#include "ResizeMonitor.h"
+
+#include <algorithm>
+#include <cstdio>
+
+//
+// Summary
+//
+
+float ResizeMonitor::Summary::GetFps() const
+{
+  return Seconds > 0 ? Frames / Seconds : 0;
+}
+
+//
+// Interface
+//
+
+void ResizeMonitor::Update(
+    const int width,
+    const int height
+  )
+{
+  // A minimized window reports 0x0, restoring it is not a resize either
+  if (width <= 0 || height <= 0)
+    return;
+
+  if (width == m_Width && height == m_Height)
+    return;
+
+  const auto Now = Clock::now();
+  const bool IsFirst = !m_HasSize;
+
+  m_Width = width;
+  m_Height = height;
+  m_HasSize = true;
+  m_LastChange = Now;
+
+  // The initial size is not a resize
+  if (IsFirst || m_IsResizing)
+    return;
+
+  m_IsResizing = true;
+  m_Summary = Summary{};
+  m_SessionStart = Now;
+  m_LastPresent = Now;
+  m_LastRebuild = Now;
+}
+
+bool ResizeMonitor::IsRebuildDue(
+    const int swapchain_width,
+    const int swapchain_height
+  ) const
+{
+  if (m_Width <= 0 || m_Height <= 0)
+    return false;
+
+  if (m_Width == swapchain_width && m_Height == swapchain_height)
+    return false;
+
+  const auto Now = Clock::now();
+  return Now - m_LastChange >= SETTLE_TIME || Now - m_LastRebuild >= REBUILD_INTERVAL;
+}
+
+void ResizeMonitor::OnRebuild(
+    const Clock::time_point start,
+    const Clock::time_point end
+  )
+{
+  m_LastRebuild = end;
+
+  if (!m_IsResizing)
+    return;
+
+  ++m_Summary.Rebuilds;
+  m_Summary.RebuildMs += std::chrono::duration<float, std::milli>(end - start).count();
+}
+
+void ResizeMonitor::OnFramePresented()
+{
+  if (!m_IsResizing)
+    return;
+
+  const auto Now = Clock::now();
+
+  // Frames after the size stopped changing are not part of the resize
+  if (Now - m_LastChange > SETTLE_TIME)
+    return;
+
+  ++m_Summary.Frames;
+  m_Summary.WorstFrameMs = std::max(m_Summary.WorstFrameMs, std::chrono::duration<float, std::milli>(Now - m_LastPresent).count());
+  m_LastPresent = Now;
+}
+
+bool ResizeMonitor::PopSummary(
+    Summary & summary
+  )
+{
+  if (!m_IsResizing || Clock::now() - m_LastChange < SESSION_END)
+    return false;
+
+  m_Summary.Seconds = std::chrono::duration<float>(m_LastPresent - m_SessionStart).count();
+  summary = m_Summary;
+  m_IsResizing = false;
+  return true;
+}
+
+bool ResizeMonitor::IsResizing() const
+{
+  return m_IsResizing;
+}
+
+void ResizeMonitor::Print(
+    std::ostream &  out,
+    const Summary & summary
+  )
+{
+  char Line[200];
+  std::snprintf(Line, sizeof(Line), "Resize: %d frames in %.2f s (%.1f fps, worst frame %.1f ms), %d swapchain rebuilds (%.2f ms avg)\n",
+      summary.Frames, summary.Seconds, summary.GetFps(), summary.WorstFrameMs,
+      summary.Rebuilds, summary.Rebuilds ? summary.RebuildMs / summary.Rebuilds : 0.0f);
+  out << Line << std::flush;
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+
+//
+// Tracks live resizes of the main window: decides when a swapchain whose
+// extent lags behind the framebuffer is rebuilt, so a burst of resize
+// events costs a few rebuilds rather than one per frame, and measures the
+// frame rate while the resize lasts.
+//
+// A resize session starts with the first size change and ends once the
+// size has been stable for SESSION_END.
+//
+
+class ResizeMonitor
+{
+public: // Types
+
+  using Clock = std::chrono::steady_clock;
+
+  struct Summary
+  {
+    int   Frames        = 0;
+    int   Rebuilds      = 0;
+    float Seconds       = 0;
+    float WorstFrameMs  = 0;
+    float RebuildMs     = 0; // Total time spent rebuilding
+
+    float GetFps() const;
+  };
+
+public: // Interface
+
+  // Called once per frame with the current framebuffer size, the empty
+  // size of a minimized window is ignored
+  void Update(
+      const int width,
+      const int height
+    );
+
+  // Whether a swapchain of the given extent is due to be rebuilt to the
+  // current size. Rebuilds wait for the size to settle, while the size
+  // keeps changing they happen every REBUILD_INTERVAL
+  bool IsRebuildDue(
+      const int swapchain_width,
+      const int swapchain_height
+    ) const;
+
+  void OnRebuild(
+      const Clock::time_point start,
+      const Clock::time_point end
+    );
+
+  void OnFramePresented();
+
+  // Reports a session once it has ended
+  bool PopSummary(
+      Summary & summary
+    );
+
+  bool IsResizing() const;
+
+  static void Print(
+      std::ostream &  out,
+      const Summary & summary
+    );
+
+private: // Members
+
+  static constexpr auto SETTLE_TIME      = std::chrono::milliseconds(50);
+  static constexpr auto REBUILD_INTERVAL = std::chrono::milliseconds(100);
+  static constexpr auto SESSION_END      = std::chrono::milliseconds(500);
+
+  int               m_Width       = 0;
+  int               m_Height      = 0;
+  bool              m_HasSize     = false;
+  Clock::time_point m_LastChange;
+  Clock::time_point m_LastRebuild;
+  Clock::time_point m_SessionStart;
+  Clock::time_point m_LastPresent;
+  bool              m_IsResizing  = false;
+  Summary           m_Summary;
+};
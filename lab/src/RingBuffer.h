@@ -0,0 +1,54 @@
+#pragma once
+
+#include <atomic>
+#include <array>
+#include <cstddef>
+
+//
+// Lock-free single producer / single consumer ring buffer with a fixed,
+// power of two capacity. When the buffer is full new values are dropped.
+//
+
+template <class T, std::size_t Capacity>
+class RingBuffer
+{
+  static_assert((Capacity & (Capacity - 1)) == 0, "Ring buffer capacity must be a power of two");
+
+public: // Producer interface
+
+  bool Push(
+      const T & value
+    )
+  {
+    const auto Head = m_Head.load(std::memory_order_relaxed);
+
+    if (Head - m_Tail.load(std::memory_order_acquire) == Capacity)
+      return false;
+
+    m_Slots[Head & (Capacity - 1)] = value;
+    m_Head.store(Head + 1, std::memory_order_release);
+    return true;
+  }
+
+public: // Consumer interface
+
+  bool Pop(
+      T & value
+    )
+  {
+    const auto Tail = m_Tail.load(std::memory_order_relaxed);
+
+    if (Tail == m_Head.load(std::memory_order_acquire))
+      return false;
+
+    value = m_Slots[Tail & (Capacity - 1)];
+    m_Tail.store(Tail + 1, std::memory_order_release);
+    return true;
+  }
+
+private: // Members
+
+  std::array<T, Capacity>  m_Slots{};
+  std::atomic<std::size_t> m_Head = 0;
+  std::atomic<std::size_t> m_Tail = 0;
+};
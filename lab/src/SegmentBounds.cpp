@@ -0,0 +1,101 @@
+#include "SegmentBounds.h"
+#include "GpuFigureRenderer.h"
+
+#include <algorithm>
+
+//
+// Interface
+//
+
+void SegmentBounds::Reset()
+{
+  m_Boxes.clear();
+  m_PointCount = 0;
+}
+
+void SegmentBounds::Update(
+    const FigureView points
+  )
+{
+  const auto Count = points.Size();
+  const auto Segments = Count >= 2 ? Count - 1 : 0;
+
+  // A segment depends on the two points on either side of it, so a moved
+  // last point or a new end touches the three segments before it
+  const auto Unchanged = std::min(m_PointCount, Count);
+  const auto FirstDirty = Unchanged >= 3 ? Unchanged - 3 : 0;
+
+  m_Boxes.resize(Segments);
+  m_PointCount = Count;
+
+  for (auto i = FirstDirty; i < Segments; ++i)
+  {
+    BoundingBox Box;
+
+    for (const auto & Point : GetSplineSegment(points, i))
+      Box.Add(Point);
+
+    Box.Expand(std::max(Box.Max.x - Box.Min.x, Box.Max.y - Box.Min.y) * HULL_PADDING);
+
+    m_Boxes[i] = Box;
+  }
+}
+
+std::size_t SegmentBounds::Size() const
+{
+  return m_Boxes.size();
+}
+
+const BoundingBox & SegmentBounds::operator[](
+    const std::size_t segment
+  ) const
+{
+  return m_Boxes[segment];
+}
+
+//
+// Drawing
+//
+
+void DrawFigure(
+    const FigureView      points,
+    const SegmentBounds & bounds,
+    const ImVec2          pos,
+    const ImU32           col,
+    const float           thickness,
+    const float           scale
+  )
+{
+  if (points.Size() < 3 || bounds.Size() != points.Size() - 1)
+  {
+    DrawCurveFigure(points, pos, col, thickness, scale);
+    return;
+  }
+
+  const auto * DrawList = ImGui::GetWindowDrawList();
+
+  const auto Margin = ImVec2{ thickness, thickness };
+  const auto ClipMin = (DrawList->GetClipRectMin() - pos - Margin) / scale;
+  const auto ClipMax = (DrawList->GetClipRectMax() - pos + Margin) / scale;
+
+  const auto Samples = GetSplineSegmentSamples(SPLINE_POINTS_PER_SEGMENT);
+
+  // Visible segments are tessellated into one run, so a fully visible
+  // figure draws exactly like the unculled version
+  std::pmr::vector<ImVec2> Run(&FrameArena::GetResource());
+
+  for (std::size_t i = 0; i < bounds.Size(); ++i)
+  {
+    if (!bounds[i].Intersects(ClipMin, ClipMax))
+    {
+      DrawCurve(Run, pos, col, thickness, scale);
+      Run.clear();
+      continue;
+    }
+
+    Run.resize(Run.size() + Samples);
+    TessellateSplineSegment(points, i, SPLINE_POINTS_PER_SEGMENT, Run.data() + Run.size() - Samples);
+  }
+
+  DrawCurve(Run, pos, col, thickness, scale);
+}
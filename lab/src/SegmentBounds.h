@@ -0,0 +1,55 @@
+#pragma once
+
+#include "FigureView.h"
+#include "ImVecUtils.h"
+
+#include <vector>
+
+//
+// Axis-aligned bounding boxes of the Catmull-Rom segments of a figure,
+// taken from each segment's control hull. They let drawing skip segments
+// outside the clip rect before tessellating them.
+//
+
+class SegmentBounds
+{
+public: // Interface
+
+  // Drops all boxes, call when the figure is replaced
+  void Reset();
+
+  // Brings the boxes in line with `points`. Since the last call the figure
+  // may only have grown or shrunk at its end and moved its last point, so
+  // only the segments next to the end are recomputed.
+  void Update(
+      const FigureView points
+    );
+
+  std::size_t Size() const;
+
+  const BoundingBox & operator[](
+      const std::size_t segment
+    ) const;
+
+private: // Constants
+
+  // Centripetal Catmull-Rom segments can leave their control hull by about
+  // a tenth of its extent, the padding keeps the boxes conservative
+  static constexpr float HULL_PADDING = 0.25f;
+
+private: // Members
+
+  std::vector<BoundingBox> m_Boxes;
+  std::size_t              m_PointCount = 0;
+};
+
+// Same as DrawFigure, but segments whose boxes miss the clip rect of the
+// current window are neither tessellated nor emitted
+void DrawFigure(
+    const FigureView      points,
+    const SegmentBounds & bounds,
+    const ImVec2          pos,
+    const ImU32           col = 0xFFFFFFFF,
+    const float           thickness = 1,
+    const float           scale = 1
+  );
@@ -2,6 +2,9 @@
 
 #include "ImVecUtils.h"
 
+#include <algorithm>
+#include <cmath>
+
 //
 // Construction
 //
@@ -18,79 +21,218 @@ SplineDrawingWindow::SplineDrawingWindow(
 // IWindow
 //
 
-std::string SplineDrawingWindow::GetWindowName() const
+std::string_view SplineDrawingWindow::GetWindowName() const
 {
   return m_WindowName;
 }
 
 void SplineDrawingWindow::UpdateFrameData()
 {
-  ImGui::BeginChild("Viewport", ImVec2(-1, -1), true);
-
   if (m_IsFirstFrame)
   {
-    m_FirstPoint = ImVec2(0, 0);
-    m_SecondPoint = ImVec2(50, 50);
-    m_FirstControlPoint = ImVec2(0, 50);
-    m_SecondControlPoint = ImVec2(50, 0);
+    for (const auto Point : { ImVec2(0, 0), ImVec2(0, 50), ImVec2(50, 0), ImVec2(50, 50) })
+      m_Points.PushBack(Point);
+
+    m_History.Reset(m_Points);
+    Rebuild();
 
     m_PreviousMousePosition = ImGui::GetMousePos();
 
     m_IsFirstFrame = false;
   }
 
-  const auto CursorPos = ImGui::GetCursorScreenPos();
+  ImGui::Text("Segments: %d, handles: %d", int(m_Tessellation.GetSegmentCount()), int(m_Points.Size()));
+
+  ImGui::SliderInt("##Segments", &m_GenerateSegments, 1, 50000, "%d segments", ImGuiSliderFlags_Logarithmic);
+  ImGui::SameLine();
+
+  if (ImGui::Button("Generate"))
+    Generate(std::size_t(std::max(m_GenerateSegments, 1)));
+
+  if (const auto Command = m_History.ShowControls(); Command != FigureHistory::Command::None && !m_DraggedPoint)
+    ApplyHistory(Command);
+
+  m_Viewport.Begin();
+
+  const auto MousePosition = ImGui::GetMousePos();
+  const bool IsHovered = ImGui::IsWindowHovered();
+
+  std::optional<std::size_t> Hovered;
+
+  if (IsHovered && !m_DraggedPoint)
+    Hovered = m_Grid.FindNearest(m_Points, m_Viewport.ToCanvas(MousePosition), HIT_RADIUS / m_Viewport.GetZoom());
+
+  if (IsHovered && !m_WasMouseDown && ImGui::IsMouseDown(ImGuiMouseButton_Left))
+    m_DraggedPoint = Hovered;
+
+  if (IsHovered && !Hovered && ImGui::IsMouseDoubleClicked(ImGuiMouseButton_Left))
+  {
+    AppendSegment(m_Viewport.ToCanvas(MousePosition));
+    m_History.Commit(m_Points);
+  }
+
+  if (m_WasMouseDown && ImGui::IsMouseReleased(ImGuiMouseButton_Left) && m_DraggedPoint)
+  {
+    m_History.Commit(m_Points);
+    m_DraggedPoint.reset();
+  }
 
-  ImGui::GetWindowDrawList()->AddCircleFilled(CursorPos + m_FirstPoint, 5, 0xFF00FF00);
-  ImGui::GetWindowDrawList()->AddCircleFilled(CursorPos + m_SecondPoint, 5, 0xFF00FF00);
+  if (m_DraggedPoint)
+    MoveHandle(*m_DraggedPoint, (MousePosition - m_PreviousMousePosition) / m_Viewport.GetZoom());
 
-  ImGui::GetWindowDrawList()->AddCircleFilled(CursorPos + m_FirstControlPoint, 5, 0xFF0000FF);
-  ImGui::GetWindowDrawList()->AddCircleFilled(CursorPos + m_SecondControlPoint, 5, 0xFF0000FF);
+  m_Tessellation.Update(m_Points);
+  m_Tessellation.Draw(m_Viewport.GetOrigin(), 0xFF00FF00, 3, m_Viewport.GetZoom());
 
-  ImGui::GetWindowDrawList()->AddLine(CursorPos + m_FirstPoint, CursorPos + m_FirstControlPoint, 0xFF0000FF, 2);
-  ImGui::GetWindowDrawList()->AddLine(CursorPos + m_SecondPoint, CursorPos + m_SecondControlPoint, 0xFF0000FF, 2);
+  DrawHandles(m_DraggedPoint ? m_DraggedPoint : Hovered);
 
-  std::vector<ImVec2> Spline;
+  m_Viewport.End();
 
-  //for (float t = 0.0f; t <= 1.0f; t += 0.01f)
-  //  Spline.push_back(BezierInterpolate(m_FirstPoint, m_SecondPoint, m_FirstControlPoint, m_SecondControlPoint, t));
+  m_PreviousMousePosition = MousePosition;
+  m_WasMouseDown = ImGui::IsMouseDown(ImGuiMouseButton_Left);
+}
 
-  Spline.insert(Spline.end(), { m_FirstPoint, m_FirstControlPoint, m_SecondControlPoint, m_SecondPoint });
+//
+// Service
+//
 
-  DrawFigure(Spline, CursorPos, 0xFF00FF00, 3);
+void SplineDrawingWindow::Rebuild()
+{
+  m_Tessellation.Reset();
+  m_Grid.Build(m_Points);
+}
 
-  //ImGui::GetWindowDrawList()->AddBezierCubic(
-  //    CursorPos + m_FirstPoint,
-  //    CursorPos + m_FirstControlPoint,
-  //    CursorPos + m_SecondControlPoint,
-  //    CursorPos + m_SecondPoint,
-  //    0xFF00FF00, 3
-  //  );
+void SplineDrawingWindow::ApplyHistory(
+    const FigureHistory::Command command
+  )
+{
+  const auto Size = m_Points.Size();
 
-  if (ImGui::IsWindowHovered() && !m_WasMouseDown && ImGui::IsMouseDown(ImGuiMouseButton_Left))
+  // Only the rewritten handles move while the path keeps its segments
+  const auto OnWrite = [&](const std::size_t first, const FigureView points)
   {
-    for (auto * PointPtr : { &m_FirstPoint, &m_SecondPoint, &m_FirstControlPoint, &m_SecondControlPoint })
+    if (m_Points.Size() != Size)
+      return;
+
+    for (std::size_t k = 0; k < points.Size(); ++k)
     {
-      if (ImVecDistance(CursorPos + *PointPtr, ImGui::GetMousePos()) < 10)
-      {
-        m_DraggedPoint = PointPtr;
-        break;
-      }
+      m_Grid.Move(first + k, m_Points[first + k], points[k]);
+      m_Tessellation.Invalidate(first + k);
     }
+  };
+
+  const bool IsApplied = command == FigureHistory::Command::Undo ? m_History.Undo(m_Points, OnWrite) : m_History.Redo(m_Points, OnWrite);
+
+  if (IsApplied && m_Points.Size() != Size)
+    Rebuild();
+}
+
+void SplineDrawingWindow::Generate(
+    const std::size_t segments
+  )
+{
+  constexpr float Step = 60;
+  constexpr float Amplitude = 40;
+
+  m_Points.Clear();
+  m_Points.Reserve(segments * 3 + 1);
+
+  // A wave along the x axis with horizontal tangents at the anchors
+  ImVec2 Previous{ 0, 0 };
+  m_Points.PushBack(Previous);
+
+  for (std::size_t i = 1; i <= segments; ++i)
+  {
+    const ImVec2 Anchor{ i * Step, Amplitude * std::sin(i * 0.5f) };
+
+    m_Points.PushBack(Previous + ImVec2{ Step / 3, 0 });
+    m_Points.PushBack(Anchor - ImVec2{ Step / 3, 0 });
+    m_Points.PushBack(Anchor);
+
+    Previous = Anchor;
   }
 
-  if (m_WasMouseDown && ImGui::IsMouseReleased(ImGuiMouseButton_Left))
-    m_DraggedPoint = nullptr;
+  Rebuild();
+  m_History.Commit(m_Points);
+}
 
-  if (m_DraggedPoint)
+void SplineDrawingWindow::AppendSegment(
+    const ImVec2 anchor
+  )
+{
+  const auto Last = m_Points.Back();
+
+  for (const auto Point : { Last + (anchor - Last) / 3, Last + (anchor - Last) * (2.f / 3), anchor })
+  {
+    m_Grid.Insert(m_Points.Size(), Point);
+    m_Points.PushBack(Point);
+  }
+}
+
+void SplineDrawingWindow::MoveHandle(
+    const std::size_t index,
+    const ImVec2      delta
+  )
+{
+  const auto Move = [&](const std::size_t i)
   {
-    const auto Delta = ImGui::GetMousePos() - m_PreviousMousePosition;
+    const auto From = m_Points[i];
+    const auto To = From + delta;
+
+    m_Points.Set(i, To);
+    m_Grid.Move(i, From, To);
+    m_Tessellation.Invalidate(i);
+  };
+
+  Move(index);
 
-    *m_DraggedPoint = *m_DraggedPoint + Delta;
+  // An anchor carries its control handles
+  if (index % 3 == 0)
+  {
+    if (index > 0)
+      Move(index - 1);
+
+    if (index + 1 < m_Points.Size())
+      Move(index + 1);
   }
+}
+
+void SplineDrawingWindow::DrawHandles(
+    const std::optional<std::size_t> hovered
+  ) const
+{
+  auto * DrawList = ImGui::GetWindowDrawList();
 
-  ImGui::EndChild();
+  const auto Zoom = m_Viewport.GetZoom();
+  const auto Margin = ImVec2{ 1, 1 } * (HANDLE_RADIUS + 2) / Zoom;
+  const auto ClipMin = m_Viewport.ToCanvas(DrawList->GetClipRectMin()) - Margin;
+  const auto ClipMax = m_Viewport.ToCanvas(DrawList->GetClipRectMax()) + Margin;
 
-  m_PreviousMousePosition = ImGui::GetMousePos();
-  m_WasMouseDown = ImGui::IsMouseDown(ImGuiMouseButton_Left);
+  const auto DrawHandle = [&](const std::size_t i, const ImU32 col)
+  {
+    DrawList->AddCircleFilled(m_Viewport.ToScreen(m_Points[i]), HANDLE_RADIUS, col);
+  };
+
+  // Only the handles of visible segments that are large enough on screen,
+  // the hull box holds all four. Neighbours in a run share their anchor.
+  m_Tessellation.FindSegments(ClipMin, ClipMax, MIN_HANDLE_SEGMENT / Zoom, [&](const std::size_t first, const std::size_t last)
+  {
+    for (auto s = first; s < last; ++s)
+    {
+      const auto i = s * 3;
+
+      DrawList->AddLine(m_Viewport.ToScreen(m_Points[i]), m_Viewport.ToScreen(m_Points[i + 1]), 0xFF0000FF, 2);
+      DrawList->AddLine(m_Viewport.ToScreen(m_Points[i + 3]), m_Viewport.ToScreen(m_Points[i + 2]), 0xFF0000FF, 2);
+
+      DrawHandle(i + 1, 0xFF0000FF);
+      DrawHandle(i + 2, 0xFF0000FF);
+      DrawHandle(i, 0xFF00FF00);
+    }
+
+    DrawHandle(last * 3, 0xFF00FF00);
+  });
+
+  // Hit tests do not depend on the zoom, the handle under the mouse is
+  // shown even when its segment is too small
+  if (hovered)
+    DrawList->AddCircleFilled(m_Viewport.ToScreen(m_Points[*hovered]), HANDLE_RADIUS + 2, 0xFFFFFFFF);
 }
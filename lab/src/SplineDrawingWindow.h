@@ -1,9 +1,26 @@
 #pragma once
 
 #include "IWindow.h"
+#include "CanvasViewport.h"
+#include "FigureBuffer.h"
+#include "FigureHistory.h"
+#include "BezierTessellation.h"
+#include "HandleGrid.h"
 
 #include <imgui.h>
 #include <vector>
+#include <optional>
+
+//
+// Cubic Bezier path editor. Dragging a handle moves it, dragging an anchor
+// moves its control handles along, a double click on the empty canvas
+// appends a segment ending there.
+//
+// Hit tests and hover go through a HandleGrid that is updated as handles
+// move, and only the segments of moved handles are re-tessellated, so the
+// cost of an edit does not grow with the path. Curve and handles are drawn
+// from the visible segments found through the tessellation's box blocks.
+//
 
 class SplineDrawingWindow :
   public IWindow
@@ -16,22 +33,56 @@ public: // Construction
 
 protected: // IWindow
 
-  std::string GetWindowName() const override;
+  std::string_view GetWindowName() const override;
 
   void UpdateFrameData() override;
 
+private: // Service
+
+  // Replaces the whole path, e.g. after an undo that changed its length
+  void Rebuild();
+
+  void ApplyHistory(
+      const FigureHistory::Command command
+    );
+
+  void Generate(
+      const std::size_t segments
+    );
+
+  void AppendSegment(
+      const ImVec2 anchor
+    );
+
+  void MoveHandle(
+      const std::size_t index,
+      const ImVec2      delta
+    );
+
+  void DrawHandles(
+      const std::optional<std::size_t> hovered
+    ) const;
+
 private: // Constants
 
+  // Screen pixels
+  static constexpr float HIT_RADIUS    = 10.f;
+  static constexpr float HANDLE_RADIUS = 5.f;
+  // Smaller segments would draw their handles as one blob
+  static constexpr float MIN_HANDLE_SEGMENT = 6 * HANDLE_RADIUS;
+
 private: // Members
 
-  std::string m_WindowName;
-  bool        m_IsFirstFrame = true;
-  ImVec2      m_FirstPoint{ 0, 0 };
-  ImVec2      m_SecondPoint{ 0, 0 };
-  ImVec2      m_FirstControlPoint{ 0, 0 };
-  ImVec2      m_SecondControlPoint{ 0, 0 };
-  ImVec2      m_PreviousMousePosition{ 0, 0 };
-  ImVec2 *    m_DraggedPoint = nullptr;
-  bool        m_WasMouseDown = false;
-};
+  std::string                m_WindowName;
+  bool                       m_IsFirstFrame = true;
+  FigureBuffer               m_Points; // A0 C C A1 C C A2 ..., see BezierTessellation
+  BezierTessellation         m_Tessellation;
+  HandleGrid                 m_Grid;
+  ImVec2                     m_PreviousMousePosition{ 0, 0 };
+  std::optional<std::size_t> m_DraggedPoint;
+  bool                       m_WasMouseDown = false;
+  int                        m_GenerateSegments = 1000;
+  FigureHistory              m_History;
 
+  CanvasViewport m_Viewport;
+};
@@ -0,0 +1,94 @@
+#include "StartupTrace.h"
+
+#include <algorithm>
+#include <cstdio>
+
+//
+// Interface
+//
+
+StartupTrace & StartupTrace::Instance()
+{
+  static StartupTrace Trace;
+  return Trace;
+}
+
+void StartupTrace::Start()
+{
+  std::lock_guard Lock(m_Mutex);
+  m_Start = Clock::now();
+  m_Spans.clear();
+  m_Threads = { std::this_thread::get_id() };
+  m_FirstFrame = -1;
+}
+
+void StartupTrace::Add(
+    std::string             name,
+    const Clock::time_point start,
+    const Clock::time_point end
+  )
+{
+  std::lock_guard Lock(m_Mutex);
+
+  const auto Id = std::this_thread::get_id();
+  auto Found = std::find(m_Threads.begin(), m_Threads.end(), Id);
+
+  if (Found == m_Threads.end())
+    Found = m_Threads.insert(m_Threads.end(), Id);
+
+  m_Spans.push_back(Span{ std::move(name), std::size_t(Found - m_Threads.begin()), ToMilliseconds(start), ToMilliseconds(end) });
+}
+
+void StartupTrace::MarkFirstFrame()
+{
+  std::lock_guard Lock(m_Mutex);
+
+  if (m_FirstFrame < 0)
+    m_FirstFrame = ToMilliseconds(Clock::now());
+}
+
+float StartupTrace::GetFirstFrame() const
+{
+  std::lock_guard Lock(m_Mutex);
+  return m_FirstFrame;
+}
+
+std::vector<StartupTrace::Span> StartupTrace::GetSpans() const
+{
+  std::lock_guard Lock(m_Mutex);
+
+  auto Result = m_Spans;
+  std::stable_sort(Result.begin(), Result.end(), [](const Span & a, const Span & b) { return a.Start < b.Start; });
+  return Result;
+}
+
+void StartupTrace::Print(
+    std::ostream & out
+  ) const
+{
+  char Line[160];
+
+  out << "Startup trace:\n";
+  std::snprintf(Line, sizeof(Line), "  %-6s %10s %10s %10s  %s\n", "thread", "start ms", "end ms", "ms", "step");
+  out << Line;
+
+  for (const auto & Span : GetSpans())
+  {
+    std::snprintf(Line, sizeof(Line), "  %-6d %10.1f %10.1f %10.1f  %s\n", int(Span.Thread), Span.Start, Span.End, Span.End - Span.Start, Span.Name.c_str());
+    out << Line;
+  }
+
+  std::snprintf(Line, sizeof(Line), "  First frame presented after %.1f ms\n", GetFirstFrame());
+  out << Line << std::flush;
+}
+
+//
+// Service
+//
+
+float StartupTrace::ToMilliseconds(
+    const Clock::time_point time
+  ) const
+{
+  return std::chrono::duration<float, std::milli>(time - m_Start).count();
+}
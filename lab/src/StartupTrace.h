@@ -0,0 +1,79 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <mutex>
+#include <thread>
+#include <chrono>
+#include <ostream>
+
+//
+// Wall-clock spans of the initialization steps, recorded from whichever
+// thread runs them, reported once the first frame is presented.
+//
+
+class StartupTrace
+{
+public: // Types
+
+  using Clock = std::chrono::steady_clock;
+
+  struct Span
+  {
+    std::string Name;
+    std::size_t Thread = 0; // In order of appearance, the first one is the main thread
+    float       Start = 0;  // Milliseconds since Start()
+    float       End = 0;
+  };
+
+public: // Interface
+
+  static StartupTrace & Instance();
+
+  void Start();
+
+  void Add(
+      std::string             name,
+      const Clock::time_point start,
+      const Clock::time_point end
+    );
+
+  // Runs the step and records its span
+  template <class Step>
+  void Run(
+      std::string name,
+      Step &&     step
+    )
+  {
+    const auto Begin = Clock::now();
+    step();
+    Add(std::move(name), Begin, Clock::now());
+  }
+
+  void MarkFirstFrame();
+
+  // Milliseconds from Start() to the first presented frame
+  float GetFirstFrame() const;
+
+  std::vector<Span> GetSpans() const;
+
+  void Print(
+      std::ostream & out
+    ) const;
+
+private: // Service
+
+  StartupTrace() = default;
+
+  float ToMilliseconds(
+      const Clock::time_point time
+    ) const;
+
+private: // Members
+
+  mutable std::mutex           m_Mutex;
+  Clock::time_point            m_Start;
+  std::vector<Span>            m_Spans;
+  std::vector<std::thread::id> m_Threads;
+  float                        m_FirstFrame = -1;
+};
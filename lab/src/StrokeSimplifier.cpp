@@ -0,0 +1,71 @@
+#include "StrokeSimplifier.h"
+
+#include "ImVecUtils.h"
+
+//
+// Interface
+//
+
+void StrokeSimplifier::Reset(
+    const float tolerance
+  )
+{
+  m_Tolerance = tolerance;
+  m_HasAnchor = false;
+  m_Pending.clear();
+}
+
+bool StrokeSimplifier::Add(
+    const ImVec2   point,
+    FigureBuffer & out
+  )
+{
+  if (!m_HasAnchor)
+  {
+    m_Anchor = point;
+    m_HasAnchor = true;
+    out.PushBack(point);
+    return true;
+  }
+
+  const auto Last = m_Pending.empty() ? m_Anchor : m_Pending.back();
+
+  if (ImVecDistance(Last, point) < MIN_POINT_DISTANCE)
+    return false;
+
+  bool NeedVertex = m_Pending.size() >= MAX_PENDING_POINTS;
+
+  for (std::size_t i = 0; i < m_Pending.size() && !NeedVertex; ++i)
+    NeedVertex = SegmentDistance(m_Pending[i], m_Anchor, point) > m_Tolerance;
+
+  if (NeedVertex)
+  {
+    m_Anchor = m_Pending.back();
+    m_Pending.clear();
+    out.PushBack(m_Anchor);
+  }
+
+  m_Pending.push_back(point);
+
+  return NeedVertex;
+}
+
+bool StrokeSimplifier::Finish(
+    FigureBuffer & out
+  )
+{
+  if (m_Pending.empty())
+    return false;
+
+  out.PushBack(m_Pending.back());
+  m_Pending.clear();
+  return true;
+}
+
+std::optional<ImVec2> StrokeSimplifier::GetPending() const
+{
+  if (m_Pending.empty())
+    return std::nullopt;
+
+  return m_Pending.back();
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "FigureBuffer.h"
+
+#include <imgui.h>
+#include <vector>
+#include <optional>
+
+//
+// Streaming Ramer-Douglas-Peucker style simplification of a stroke.
+//
+// Points arrive one by one. The simplifier keeps the points since the last
+// emitted vertex and emits the previous point as soon as one of the kept
+// points deviates from the chord (last vertex -> newest point) by more
+// than the tolerance, so every dropped point stays within the tolerance
+// of the simplified polyline.
+//
+
+class StrokeSimplifier
+{
+public: // Interface
+
+  void Reset(
+      const float tolerance
+    );
+
+  // Returns true when a vertex was appended to `out`
+  bool Add(
+      const ImVec2   point,
+      FigureBuffer & out
+    );
+
+  // Appends the last pending point, if any
+  bool Finish(
+      FigureBuffer & out
+    );
+
+  // Newest point that is not a vertex yet
+  std::optional<ImVec2> GetPending() const;
+
+private: // Constants
+
+  // Bounds the per-point cost on long straight strokes
+  static constexpr std::size_t MAX_PENDING_POINTS = 256;
+
+  // Cursor jitter below this is ignored
+  static constexpr float MIN_POINT_DISTANCE = 0.5f;
+
+private: // Members
+
+  float               m_Tolerance = 1;
+  bool                m_HasAnchor = false;
+  ImVec2              m_Anchor;
+  std::vector<ImVec2> m_Pending;
+};
@@ -0,0 +1,224 @@
+#include "ThreadPool.h"
+
+#include <algorithm>
+
+namespace
+{
+
+// Queue owned by the current thread, if it is a pool worker
+thread_local const ThreadPool * t_Pool      = nullptr;
+thread_local std::size_t        t_QueueIndex = 0;
+
+// Upper bound of chunks per thread in ParallelFor, keeps stealing possible
+// without drowning the queues in tiny tasks
+constexpr std::size_t CHUNKS_PER_THREAD = 4;
+
+} // namespace
+
+//
+// Construction / Destruction
+//
+
+ThreadPool::ThreadPool(
+    const std::size_t thread_count
+  )
+{
+  const auto Count = std::max<std::size_t>(thread_count, 1);
+
+  for (std::size_t i = 0; i < Count; ++i)
+    m_Queues.push_back(std::make_unique<Queue>());
+
+  for (std::size_t i = 0; i < Count; ++i)
+    m_Threads.emplace_back(&ThreadPool::WorkerLoop, this, i);
+}
+
+ThreadPool::~ThreadPool()
+{
+  {
+    std::lock_guard Lock(m_SleepMutex);
+    m_Stop = true;
+  }
+
+  m_SleepCondition.notify_all();
+
+  for (auto & Thread : m_Threads)
+    Thread.join();
+}
+
+//
+// Interface
+//
+
+ThreadPool & ThreadPool::Instance()
+{
+  // The calling thread helps while it waits, so leave one core for it
+  static ThreadPool Pool(std::max(std::thread::hardware_concurrency(), 2u) - 1);
+  return Pool;
+}
+
+std::size_t ThreadPool::GetThreadCount() const
+{
+  return m_Threads.size();
+}
+
+void ThreadPool::ParallelFor(
+    const std::size_t                                     begin,
+    const std::size_t                                     end,
+    const std::size_t                                     grain,
+    const std::function<void(std::size_t, std::size_t)> & body
+  )
+{
+  if (begin >= end)
+    return;
+
+  const auto Count = end - begin;
+  const auto MaxChunks = (GetThreadCount() + 1) * CHUNKS_PER_THREAD;
+  const auto Chunk = std::max({ grain, (Count + MaxChunks - 1) / MaxChunks, std::size_t(1) });
+
+  if (Count <= Chunk)
+  {
+    body(begin, end);
+    return;
+  }
+
+  TaskGroup Group(*this);
+
+  for (auto ChunkBegin = begin; ChunkBegin < end; ChunkBegin += Chunk)
+  {
+    const auto ChunkEnd = std::min(ChunkBegin + Chunk, end);
+
+    // Keep the last chunk for the calling thread
+    if (ChunkEnd == end)
+      body(ChunkBegin, ChunkEnd);
+    else
+      Group.Run([&body, ChunkBegin, ChunkEnd] { body(ChunkBegin, ChunkEnd); });
+  }
+
+  Group.Wait();
+}
+
+//
+// Service
+//
+
+void ThreadPool::Push(
+    Task && task
+  )
+{
+  const auto Index = t_Pool == this
+    ? t_QueueIndex
+    : m_NextQueue.fetch_add(1, std::memory_order_relaxed) % m_Queues.size();
+
+  m_PendingCount.fetch_add(1, std::memory_order_release);
+
+  {
+    std::lock_guard Lock(m_Queues[Index]->Mutex);
+    m_Queues[Index]->Tasks.push_back(std::move(task));
+  }
+
+  // Taking the sleep mutex orders the counter update with a worker that is
+  // about to wait, so the notification cannot get lost
+  {
+    std::lock_guard Lock(m_SleepMutex);
+  }
+
+  m_SleepCondition.notify_one();
+}
+
+bool ThreadPool::TryRunOne()
+{
+  const bool IsWorker = t_Pool == this;
+  const auto Start = IsWorker ? t_QueueIndex : 0;
+
+  for (std::size_t k = 0; k < m_Queues.size(); ++k)
+  {
+    auto & Queue = *m_Queues[(Start + k) % m_Queues.size()];
+
+    Task Current;
+
+    {
+      std::lock_guard Lock(Queue.Mutex);
+
+      if (Queue.Tasks.empty())
+        continue;
+
+      // Own queue is used as a stack for locality, other queues are robbed
+      // from the opposite end where the largest pieces of work sit
+      if (IsWorker && k == 0)
+      {
+        Current = std::move(Queue.Tasks.back());
+        Queue.Tasks.pop_back();
+      }
+      else
+      {
+        Current = std::move(Queue.Tasks.front());
+        Queue.Tasks.pop_front();
+      }
+    }
+
+    m_PendingCount.fetch_sub(1, std::memory_order_relaxed);
+
+    Current.Func();
+
+    if (Current.Group)
+      Current.Group->m_Pending.fetch_sub(1, std::memory_order_acq_rel);
+
+    return true;
+  }
+
+  return false;
+}
+
+void ThreadPool::WorkerLoop(
+    const std::size_t index
+  )
+{
+  t_Pool = this;
+  t_QueueIndex = index;
+
+  while (true)
+  {
+    if (TryRunOne())
+      continue;
+
+    std::unique_lock Lock(m_SleepMutex);
+    m_SleepCondition.wait(Lock, [this] { return m_Stop || m_PendingCount.load(std::memory_order_acquire) > 0; });
+
+    if (m_Stop)
+      return;
+  }
+}
+
+//
+// TaskGroup
+//
+
+TaskGroup::TaskGroup(
+    ThreadPool & pool
+  ) :
+    m_Pool(pool)
+{
+  // Empty
+}
+
+TaskGroup::~TaskGroup()
+{
+  Wait();
+}
+
+void TaskGroup::Run(
+    std::function<void()> func
+  )
+{
+  m_Pending.fetch_add(1, std::memory_order_relaxed);
+  m_Pool.Push(ThreadPool::Task{ std::move(func), this });
+}
+
+void TaskGroup::Wait()
+{
+  while (m_Pending.load(std::memory_order_acquire) > 0)
+  {
+    if (!m_Pool.TryRunOne())
+      std::this_thread::yield();
+  }
+}
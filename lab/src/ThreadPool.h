@@ -0,0 +1,124 @@
+#pragma once
+
+#include <vector>
+#include <deque>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+#include <cstddef>
+
+class TaskGroup;
+
+//
+// Work-stealing thread pool shared by the geometry kernels.
+//
+// Every worker owns a task deque: it pops its own tasks LIFO and steals
+// from the other deques FIFO when it runs dry. Threads waiting on a
+// TaskGroup execute queued tasks instead of blocking, so fork/join nests
+// freely without deadlocks.
+//
+
+class ThreadPool
+{
+public: // Construction / Destruction
+
+  explicit ThreadPool(
+      const std::size_t thread_count
+    );
+
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool &) = delete;
+  ThreadPool & operator=(const ThreadPool &) = delete;
+
+public: // Interface
+
+  // Shared pool sized to the hardware concurrency
+  static ThreadPool & Instance();
+
+  std::size_t GetThreadCount() const;
+
+  // Calls body(chunk_begin, chunk_end) for chunks of at least `grain`
+  // indices covering [begin, end) and returns when all of them are done
+  void ParallelFor(
+      const std::size_t                                         begin,
+      const std::size_t                                         end,
+      const std::size_t                                         grain,
+      const std::function<void(std::size_t, std::size_t)> &     body
+    );
+
+private: // Types
+
+  struct Task
+  {
+    std::function<void()> Func;
+    TaskGroup *            Group = nullptr;
+  };
+
+  struct Queue
+  {
+    std::mutex       Mutex;
+    std::deque<Task> Tasks;
+  };
+
+private: // Service
+
+  friend class TaskGroup;
+
+  void Push(
+      Task && task
+    );
+
+  bool TryRunOne();
+
+  void WorkerLoop(
+      const std::size_t index
+    );
+
+private: // Members
+
+  std::vector<std::unique_ptr<Queue>> m_Queues;
+  std::vector<std::thread>            m_Threads;
+  std::atomic<std::size_t>            m_NextQueue    = 0;
+  std::atomic<std::size_t>            m_PendingCount = 0;
+  std::mutex                          m_SleepMutex;
+  std::condition_variable             m_SleepCondition;
+  bool                                m_Stop = false;
+};
+
+//
+// Fork/join scope: Run() forks a task into the pool, Wait() joins all of
+// them while helping to execute queued work.
+//
+
+class TaskGroup
+{
+public: // Construction / Destruction
+
+  explicit TaskGroup(
+      ThreadPool & pool = ThreadPool::Instance()
+    );
+
+  ~TaskGroup();
+
+  TaskGroup(const TaskGroup &) = delete;
+  TaskGroup & operator=(const TaskGroup &) = delete;
+
+public: // Interface
+
+  void Run(
+      std::function<void()> func
+    );
+
+  void Wait();
+
+private: // Members
+
+  friend class ThreadPool;
+
+  ThreadPool &             m_Pool;
+  std::atomic<std::size_t> m_Pending = 0;
+};
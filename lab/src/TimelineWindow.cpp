@@ -0,0 +1,180 @@
+#include "TimelineWindow.h"
+
+#include "MorphingWindow.h"
+#include "ImVecUtils.h"
+#include "GpuFigureRenderer.h"
+
+#include <algorithm>
+#include <cmath>
+
+//
+// Construction
+//
+
+TimelineWindow::TimelineWindow(
+    const std::string & window_name,
+    const std::vector<std::shared_ptr<DrawFigureWindow>> & sources
+  ) :
+    m_WindowName(window_name),
+    m_Sources(sources)
+{
+  // Empty
+}
+
+//
+// IWindow
+//
+
+std::string_view TimelineWindow::GetWindowName() const
+{
+  return m_WindowName;
+}
+
+void TimelineWindow::UpdateFrameData()
+{
+  ShowKeyframes();
+  UpdatePlayback();
+
+  m_Snapshots.clear();
+
+  for (const auto & Key : m_Keyframes)
+    m_Snapshots.push_back(Key.Figure);
+
+  m_Worker.Submit(m_Snapshots, m_Correspondence);
+
+  // Pairs still being matched keep showing the previous result, which
+  // may be shorter or longer than the current chain
+  const auto & Result = m_Worker.GetResult();
+  const auto Count = m_Keyframes.size() >= 2 ? std::min(Result.Segments.size(), m_Keyframes.size() - 1) : 0;
+
+  if (m_Worker.IsBusy())
+    ImGui::TextUnformatted("Matching keyframes...");
+
+  m_Viewport.Begin();
+
+  if (Count > 0)
+  {
+    // Only the active pair is interpolated, its correspondence is cached
+    const auto Index = std::min(std::size_t(m_Time), Count - 1);
+    const auto & Active = *Result.Segments[Index];
+    const auto Interpolate = MorphingWindow::INTERPOLATE_METHODS[m_Keyframes[Index].Easing].second;
+    const auto t = std::min(m_Time - Index, 1.f);
+
+    const auto Morphed = Morph(Active.FirstPoints, Active.SecondPoints, t, Interpolate, FrameArena::GetResource());
+
+    if (Morphed.size() >= 2)
+    {
+      DrawCurveFigure(
+          Morphed,
+          m_Viewport.GetOrigin(), IM_COL32(255 * t, 255 * (1 - t), 0, 255), 3, m_Viewport.GetZoom()
+        );
+    }
+  }
+  else
+  if (m_Keyframes.size() == 1 && m_Keyframes.front().Figure.Size() >= 2)
+  {
+    DrawCurveFigure(m_Keyframes.front().Figure.GetPoints(), m_Viewport.GetOrigin(), 0xFF00FF00, 3, m_Viewport.GetZoom());
+  }
+
+  m_Viewport.End();
+}
+
+bool TimelineWindow::IsAnimating() const
+{
+  // Keeps frames coming until the worker's result is drawn
+  return m_IsPlaying || m_Worker.IsBusy();
+}
+
+//
+// Service
+//
+
+void TimelineWindow::ShowKeyframes()
+{
+  for (std::size_t i = 0; i < m_Sources.size(); ++i)
+  {
+    if (i > 0)
+      ImGui::SameLine();
+
+    const auto Label = "Add figure " + std::to_string(i + 1);
+
+    if (ImGui::Button(Label.c_str()))
+      m_Keyframes.push_back({ m_Sources[i]->GetSnapshot() });
+  }
+
+  for (const auto & [Name, Method] : MorphingWindow::CORRESPONDENCE_METHODS)
+  {
+    if (ImGui::RadioButton(Name.c_str(), m_Correspondence == Method))
+      m_Correspondence = Method;
+
+    ImGui::SameLine();
+  }
+
+  ImGui::TextUnformatted("Correspondence");
+
+  // Removal and reordering are applied after the loop
+  std::ptrdiff_t Remove = -1, MoveUp = -1;
+
+  for (std::size_t i = 0; i < m_Keyframes.size(); ++i)
+  {
+    auto & Key = m_Keyframes[i];
+
+    ImGui::PushID(int(i));
+    ImGui::Text("%d: %d points", int(i), int(Key.Figure.Size()));
+
+    if (i + 1 < m_Keyframes.size())
+    {
+      ImGui::SameLine();
+      ImGui::SetNextItemWidth(120);
+
+      if (ImGui::BeginCombo("##easing", MorphingWindow::INTERPOLATE_METHODS[Key.Easing].first.c_str()))
+      {
+        for (std::size_t n = 0; n < MorphingWindow::INTERPOLATE_METHODS.size(); ++n)
+        {
+          if (ImGui::Selectable(MorphingWindow::INTERPOLATE_METHODS[n].first.c_str(), Key.Easing == n))
+            Key.Easing = n;
+        }
+
+        ImGui::EndCombo();
+      }
+    }
+
+    ImGui::SameLine();
+
+    if (ImGui::SmallButton("Up") && i > 0)
+      MoveUp = i;
+
+    ImGui::SameLine();
+
+    if (ImGui::SmallButton("Remove"))
+      Remove = i;
+
+    ImGui::PopID();
+  }
+
+  if (MoveUp > 0)
+    std::swap(m_Keyframes[MoveUp - 1].Figure, m_Keyframes[MoveUp].Figure);
+
+  if (Remove >= 0)
+    m_Keyframes.erase(m_Keyframes.begin() + Remove);
+
+  if (m_Keyframes.size() >= 2)
+  {
+    if (ImGui::SliderFloat("Time", &m_Time, 0, float(m_Keyframes.size() - 1)))
+      m_IsPlaying = false;
+
+    ImGui::Checkbox("Play", &m_IsPlaying);
+    ImGui::SameLine();
+    ImGui::SliderFloat("Speed", &m_Speed, 0.05f, 5.f, "%.2f keys/s");
+  }
+}
+
+void TimelineWindow::UpdatePlayback()
+{
+  const auto Duration = m_Keyframes.size() >= 2 ? float(m_Keyframes.size() - 1) : 0.f;
+
+  if (m_IsPlaying && Duration > 0)
+    m_Time = std::fmod(m_Time + ImGui::GetIO().DeltaTime * m_Speed, Duration);
+
+  m_Time = std::clamp(m_Time, 0.f, Duration);
+}
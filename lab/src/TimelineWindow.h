@@ -0,0 +1,66 @@
+#pragma once
+
+#include "IWindow.h"
+#include "DrawFigureWindow.h"
+#include "TimelineWorker.h"
+#include "CanvasViewport.h"
+
+#include <imgui.h>
+#include <vector>
+#include <memory>
+#include <string>
+
+//
+// Morph animation through a chain of keyframes (A -> B -> C ...).
+//
+// Keyframes are snapshots of the figure windows. The correspondence of
+// every adjacent pair is computed once on a TimelineWorker, when one of
+// its keyframes changes, so playback and scrubbing only interpolate the
+// active pair and never wait for matching.
+//
+
+class TimelineWindow :
+  public IWindow
+{
+public: // Construction
+
+  TimelineWindow(
+      const std::string & window_name,
+      const std::vector<std::shared_ptr<DrawFigureWindow>> & sources
+    );
+
+protected: // IWindow
+
+  std::string_view GetWindowName() const override;
+
+  void UpdateFrameData() override;
+
+  bool IsAnimating() const override;
+
+private: // Types
+
+  struct Keyframe
+  {
+    FigureSnapshot Figure;
+    std::size_t    Easing = 0; // Index in INTERPOLATE_METHODS, towards the next keyframe
+  };
+
+private: // Service
+
+  void ShowKeyframes();
+
+  void UpdatePlayback();
+
+private: // Members
+
+  std::string                                    m_WindowName;
+  std::vector<std::shared_ptr<DrawFigureWindow>> m_Sources;
+  std::vector<Keyframe>                          m_Keyframes;
+  std::vector<FigureSnapshot>                    m_Snapshots; // Of m_Keyframes, reused every frame
+  CorrespondenceMethod                           m_Correspondence = CorrespondenceMethod::Index;
+  float                                          m_Time = 0;
+  float                                          m_Speed = 0.5f; // Keyframes per second
+  bool                                           m_IsPlaying = false;
+  CanvasViewport                                 m_Viewport;
+  TimelineWorker                                 m_Worker;
+};
@@ -0,0 +1,144 @@
+#include "TimelineWorker.h"
+
+#include "ThreadPool.h"
+
+#include <algorithm>
+
+//
+// Construction / Destruction
+//
+
+TimelineWorker::TimelineWorker()
+{
+  m_Thread = std::thread(&TimelineWorker::ThreadFunc, this);
+}
+
+TimelineWorker::~TimelineWorker()
+{
+  {
+    std::lock_guard Lock(m_Mutex);
+    m_Stop = true;
+  }
+
+  m_Condition.notify_one();
+  m_Thread.join();
+}
+
+//
+// Interface
+//
+
+void TimelineWorker::Submit(
+    const std::vector<FigureSnapshot> & keyframes,
+    const CorrespondenceMethod          correspondence
+  )
+{
+  if (keyframes == m_LastSubmitted.Keyframes && correspondence == m_LastSubmitted.Correspondence)
+    return;
+
+  m_LastSubmitted = TimelineRequest{ keyframes, correspondence, m_LastSubmitted.Version + 1 };
+
+  {
+    std::lock_guard Lock(m_Mutex);
+    m_Pending = m_LastSubmitted;
+  }
+
+  m_Condition.notify_one();
+}
+
+const TimelineResult & TimelineWorker::GetResult()
+{
+  m_Results.Acquire();
+
+  const auto & Result = m_Results.GetReadBuffer();
+  m_AcquiredVersion = Result.Version;
+
+  return Result;
+}
+
+bool TimelineWorker::IsBusy() const
+{
+  return m_AcquiredVersion != m_LastSubmitted.Version;
+}
+
+//
+// Service
+//
+
+void TimelineWorker::ThreadFunc()
+{
+  while (true)
+  {
+    TimelineRequest Request;
+
+    {
+      std::unique_lock Lock(m_Mutex);
+      m_Condition.wait(Lock, [this] { return m_Stop || m_Pending.has_value(); });
+
+      if (m_Stop)
+        return;
+
+      Request = std::move(*m_Pending);
+      m_Pending.reset();
+    }
+
+    Process(Request, m_Results.GetWriteBuffer());
+    m_Results.Publish();
+  }
+}
+
+void TimelineWorker::Process(
+    const TimelineRequest & request,
+    TimelineResult &        result
+  )
+{
+  const auto Count = request.Keyframes.size() >= 2 ? request.Keyframes.size() - 1 : 0;
+
+  result.Segments.assign(Count, nullptr);
+  result.Version = request.Version;
+
+  // Drawn keyframes are gathered here, so the UI thread finds them ready
+  // when it draws a lone keyframe
+  for (const auto & Keyframe : request.Keyframes)
+    Keyframe.GetPoints();
+
+  std::vector<std::size_t> Stale;
+
+  // Pairs are looked up by their keyframes rather than their index, so
+  // inserting, removing or reordering keyframes keeps the untouched pairs
+  for (std::size_t i = 0; i < Count; ++i)
+  {
+    const auto Cached = std::find_if(m_Cache.begin(), m_Cache.end(), [&](const auto & segment)
+      {
+        return segment->First == request.Keyframes[i]
+            && segment->Second == request.Keyframes[i + 1]
+            && segment->Method == request.Correspondence;
+      });
+
+    if (Cached != m_Cache.end())
+      result.Segments[i] = *Cached;
+    else
+      Stale.push_back(i);
+  }
+
+  // Editing one keyframe touches at most two pairs, loading a whole
+  // sequence or switching the method rebuilds all of them in parallel
+  ThreadPool::Instance().ParallelFor(0, Stale.size(), 1, [&](const std::size_t begin, const std::size_t end)
+  {
+    for (auto k = begin; k < end; ++k)
+    {
+      const auto i = Stale[k];
+      auto Pair = std::make_shared<TimelineSegment>();
+
+      Pair->First = request.Keyframes[i];
+      Pair->Second = request.Keyframes[i + 1];
+      Pair->Method = request.Correspondence;
+
+      std::tie(Pair->FirstPoints, Pair->SecondPoints) = MatchFigures(Pair->First.GetPoints(), Pair->Second.GetPoints(), Pair->Method);
+
+      result.Segments[i] = std::move(Pair);
+    }
+  });
+
+  m_Cache = result.Segments;
+}
@@ -0,0 +1,102 @@
+#pragma once
+
+#include "TripleBuffer.h"
+#include "MorphWorker.h"
+#include "Correspondence.h"
+
+#include <imgui.h>
+#include <vector>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <optional>
+#include <cstdint>
+
+//
+// Matches the adjacent keyframe pairs of a timeline off the UI thread.
+// The UI thread submits the keyframe chain, the worker publishes the
+// matched pairs through a triple buffer, reusing every pair whose two
+// keyframes and method did not change. Until the result of the latest
+// request lands the previous one stays readable.
+//
+
+struct TimelineRequest
+{
+  std::vector<FigureSnapshot> Keyframes;
+  CorrespondenceMethod        Correspondence = CorrespondenceMethod::Index;
+  std::uint64_t               Version = 0;
+
+  bool operator==(const TimelineRequest & other) const = default;
+};
+
+struct TimelineSegment
+{
+  FigureSnapshot       First;
+  FigureSnapshot       Second;
+  CorrespondenceMethod Method = CorrespondenceMethod::Index;
+  std::vector<ImVec2>  FirstPoints;
+  std::vector<ImVec2>  SecondPoints;
+};
+
+struct TimelineResult
+{
+  // One per adjacent pair of the request's keyframes, shared with the
+  // worker's cache so publishing does not copy the points
+  std::vector<std::shared_ptr<const TimelineSegment>> Segments;
+
+  // Of the request this result answers
+  std::uint64_t                                       Version = 0;
+};
+
+class TimelineWorker
+{
+public: // Construction / Destruction
+
+  TimelineWorker();
+
+  ~TimelineWorker();
+
+  TimelineWorker(const TimelineWorker &) = delete;
+  TimelineWorker & operator=(const TimelineWorker &) = delete;
+
+public: // Interface
+
+  // Replaces any request the worker has not started yet, an unchanged
+  // chain keeps the version of the previous request
+  void Submit(
+      const std::vector<FigureSnapshot> & keyframes,
+      const CorrespondenceMethod          correspondence
+    );
+
+  // Latest complete result, only valid on the submitting (UI) thread
+  const TimelineResult & GetResult();
+
+  // True until the result of the latest request was acquired
+  bool IsBusy() const;
+
+private: // Service
+
+  void ThreadFunc();
+
+  void Process(
+      const TimelineRequest & request,
+      TimelineResult &        result
+    );
+
+private: // Members
+
+  std::mutex                     m_Mutex;
+  std::condition_variable        m_Condition;
+  std::optional<TimelineRequest> m_Pending;
+  TimelineRequest                m_LastSubmitted;
+  bool                           m_Stop = false;
+
+  TripleBuffer<TimelineResult>   m_Results;
+  std::uint64_t                  m_AcquiredVersion = 0;
+
+  // Worker thread only: the segments of the previous request
+  std::vector<std::shared_ptr<const TimelineSegment>> m_Cache;
+
+  std::thread                    m_Thread;
+};
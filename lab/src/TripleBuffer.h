@@ -0,0 +1,60 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+//
+// Lock-free single producer / single consumer triple buffer.
+//
+// The producer fills GetWriteBuffer() and calls Publish(), the consumer
+// calls Acquire() and reads the most recent complete value. Neither side
+// ever waits for the other: the producer always owns one slot, the
+// consumer owns another and the third one is exchanged atomically.
+//
+
+template <class T>
+class TripleBuffer
+{
+public: // Producer interface
+
+  T & GetWriteBuffer()
+  {
+    return m_Slots[m_WriteIndex];
+  }
+
+  void Publish()
+  {
+    const auto Previous = m_Shared.exchange(static_cast<std::uint8_t>(m_WriteIndex | DIRTY_BIT), std::memory_order_acq_rel);
+    m_WriteIndex = Previous & INDEX_MASK;
+  }
+
+public: // Consumer interface
+
+  // Returns true when a newer value was published since the last call
+  bool Acquire()
+  {
+    if (!(m_Shared.load(std::memory_order_relaxed) & DIRTY_BIT))
+      return false;
+
+    const auto Previous = m_Shared.exchange(m_ReadIndex, std::memory_order_acq_rel);
+    m_ReadIndex = Previous & INDEX_MASK;
+    return true;
+  }
+
+  const T & GetReadBuffer() const
+  {
+    return m_Slots[m_ReadIndex];
+  }
+
+private: // Constants
+
+  static constexpr std::uint8_t INDEX_MASK = 0x3;
+  static constexpr std::uint8_t DIRTY_BIT  = 0x4;
+
+private: // Members
+
+  T                         m_Slots[3];
+  std::uint8_t              m_WriteIndex = 0;
+  std::atomic<std::uint8_t> m_Shared     = 1;
+  std::uint8_t              m_ReadIndex  = 2;
+};
@@ -0,0 +1,152 @@
+#include "VulkanHelpers.h"
+
+#include <fstream>
+#include <iostream>
+#include <vector>
+#include <stdexcept>
+#include <cstdint>
+
+namespace
+{
+
+bool FindMemoryType(
+    VkPhysicalDevice            physical_device,
+    const std::uint32_t         type_bits,
+    const VkMemoryPropertyFlags properties,
+    std::uint32_t &             index
+  )
+{
+  VkPhysicalDeviceMemoryProperties Memory;
+  vkGetPhysicalDeviceMemoryProperties(physical_device, &Memory);
+
+  for (std::uint32_t i = 0; i < Memory.memoryTypeCount; ++i)
+  {
+    if ((type_bits & (1u << i)) && (Memory.memoryTypes[i].propertyFlags & properties) == properties)
+    {
+      index = i;
+      return true;
+    }
+  }
+
+  return false;
+}
+
+} // namespace
+
+void CheckVulkan(
+    const VkResult      result,
+    const std::string & what
+  )
+{
+  if (result != VK_SUCCESS)
+    throw std::runtime_error(what + " (VkResult " + std::to_string(result) + ")");
+}
+
+HostBuffer CreateHostBuffer(
+    VkPhysicalDevice              physical_device,
+    VkDevice                      device,
+    const VkAllocationCallbacks * allocator,
+    const VkDeviceSize            size,
+    const VkBufferUsageFlags      usage
+  )
+{
+  HostBuffer Result;
+  Result.Size = size;
+
+  VkBufferCreateInfo BufferInfo = {};
+  BufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+  BufferInfo.size = size;
+  BufferInfo.usage = usage;
+  BufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+  CheckVulkan(vkCreateBuffer(device, &BufferInfo, allocator, &Result.Buffer), "Vulkan: Failed to create a buffer");
+
+  VkMemoryRequirements Requirements;
+  vkGetBufferMemoryRequirements(device, Result.Buffer, &Requirements);
+
+  const VkMemoryPropertyFlags HostVisible = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+
+  VkMemoryAllocateInfo AllocateInfo = {};
+  AllocateInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+  AllocateInfo.allocationSize = Requirements.size;
+
+  if (!FindMemoryType(physical_device, Requirements.memoryTypeBits, HostVisible | VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, AllocateInfo.memoryTypeIndex)
+   && !FindMemoryType(physical_device, Requirements.memoryTypeBits, HostVisible, AllocateInfo.memoryTypeIndex))
+  {
+    DestroyHostBuffer(device, allocator, Result);
+    throw std::runtime_error("Vulkan: No host visible memory type");
+  }
+
+  try
+  {
+    CheckVulkan(vkAllocateMemory(device, &AllocateInfo, allocator, &Result.Memory), "Vulkan: Failed to allocate buffer memory");
+    CheckVulkan(vkBindBufferMemory(device, Result.Buffer, Result.Memory, 0), "Vulkan: Failed to bind buffer memory");
+    CheckVulkan(vkMapMemory(device, Result.Memory, 0, size, 0, &Result.Data), "Vulkan: Failed to map buffer memory");
+  }
+  catch (...)
+  {
+    DestroyHostBuffer(device, allocator, Result);
+    throw;
+  }
+
+  return Result;
+}
+
+void DestroyHostBuffer(
+    VkDevice                      device,
+    const VkAllocationCallbacks * allocator,
+    HostBuffer &                  buffer
+  )
+{
+  if (buffer.Data)
+    vkUnmapMemory(device, buffer.Memory);
+
+  if (buffer.Buffer)
+    vkDestroyBuffer(device, buffer.Buffer, allocator);
+
+  if (buffer.Memory)
+    vkFreeMemory(device, buffer.Memory, allocator);
+
+  buffer = HostBuffer{};
+}
+
+VkShaderModule LoadShaderModule(
+    VkDevice                      device,
+    const VkAllocationCallbacks * allocator,
+    const std::string &           path
+  )
+{
+  std::ifstream In(path, std::ios::binary | std::ios::ate);
+
+  if (!In)
+  {
+    std::cerr << "Vulkan: Shader " << path << " not found, compile it with shaders/compile.sh" << std::endl;
+    return VK_NULL_HANDLE;
+  }
+
+  const auto Size = std::size_t(In.tellg());
+
+  if (Size == 0 || Size % sizeof(std::uint32_t) != 0)
+  {
+    std::cerr << "Vulkan: Shader " << path << " is not SPIR-V" << std::endl;
+    return VK_NULL_HANDLE;
+  }
+
+  std::vector<std::uint32_t> Code(Size / sizeof(std::uint32_t));
+  In.seekg(0);
+  In.read(reinterpret_cast<char *>(Code.data()), Size);
+
+  if (!In)
+  {
+    std::cerr << "Vulkan: Failed to read shader " << path << std::endl;
+    return VK_NULL_HANDLE;
+  }
+
+  VkShaderModuleCreateInfo Info = {};
+  Info.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
+  Info.codeSize = Size;
+  Info.pCode = Code.data();
+
+  VkShaderModule Result = VK_NULL_HANDLE;
+  CheckVulkan(vkCreateShaderModule(device, &Info, allocator, &Result), "Vulkan: Failed to create a shader module from " + path);
+  return Result;
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+
+#include <string>
+
+//
+// Small pieces shared by the Vulkan based renderers: persistently mapped
+// host visible buffers and SPIR-V loading. Failures of the Vulkan calls
+// are reported as std::runtime_error prefixed with `owner`.
+//
+
+struct HostBuffer
+{
+  VkBuffer       Buffer = VK_NULL_HANDLE;
+  VkDeviceMemory Memory = VK_NULL_HANDLE;
+  void *         Data   = nullptr;
+  VkDeviceSize   Size   = 0;
+};
+
+void CheckVulkan(
+    const VkResult      result,
+    const std::string & what
+  );
+
+// Prefers device local memory the host can also map (unified memory,
+// software drivers), otherwise any host visible coherent memory
+HostBuffer CreateHostBuffer(
+    VkPhysicalDevice              physical_device,
+    VkDevice                      device,
+    const VkAllocationCallbacks * allocator,
+    const VkDeviceSize            size,
+    const VkBufferUsageFlags      usage
+  );
+
+void DestroyHostBuffer(
+    VkDevice                      device,
+    const VkAllocationCallbacks * allocator,
+    HostBuffer &                  buffer
+  );
+
+// Returns VK_NULL_HANDLE and logs the path when the file is missing or is
+// not SPIR-V
+VkShaderModule LoadShaderModule(
+    VkDevice                      device,
+    const VkAllocationCallbacks * allocator,
+    const std::string &           path
+  );
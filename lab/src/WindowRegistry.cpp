@@ -0,0 +1,62 @@
+#include "WindowRegistry.h"
+
+#include <algorithm>
+
+//
+// Interface
+//
+
+void WindowRegistry::Add(
+    std::shared_ptr<IWindow> window
+  )
+{
+  Entry New;
+  New.Window = std::move(window);
+  UpdateLabel(New);
+  m_Entries.push_back(std::move(New));
+}
+
+void WindowRegistry::Show()
+{
+  for (auto & Entry : m_Entries)
+  {
+    if (Entry.Window->GetWindowName() != Entry.Name)
+      UpdateLabel(Entry);
+
+    Entry.Window->Show(Entry.Label.c_str());
+  }
+}
+
+std::size_t WindowRegistry::GetSize() const
+{
+  return m_Entries.size();
+}
+
+const char * WindowRegistry::GetLabel(
+    const std::size_t i
+  ) const
+{
+  return m_Entries[i].Label.c_str();
+}
+
+bool WindowRegistry::IsAnimating() const
+{
+  return std::any_of(m_Entries.begin(), m_Entries.end(), [](const Entry & entry)
+    {
+      return entry.Window->IsVisible() && entry.Window->IsAnimating();
+    });
+}
+
+//
+// Service
+//
+
+void WindowRegistry::UpdateLabel(
+    Entry & entry
+  )
+{
+  // The part after "###" is the ImGui ID, a renamed window keeps its
+  // position and docking
+  entry.Name = entry.Window->GetWindowName();
+  entry.Label = entry.Window->GetWindowNameID();
+}
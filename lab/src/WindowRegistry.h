@@ -0,0 +1,58 @@
+#pragma once
+
+#include "IWindow.h"
+
+#include <vector>
+#include <memory>
+#include <string>
+#include <cstddef>
+
+//
+// The application's windows with their ImGui labels. A label is rebuilt
+// only when GetWindowName() changes, so showing the windows allocates
+// nothing in a steady state frame.
+//
+// Visibility is collected as the windows are shown: a collapsed window or
+// one behind another tab of its dock node skips UpdateFrameData(), which
+// pauses its animation, and does not keep the main loop running.
+//
+
+class WindowRegistry
+{
+public: // Interface
+
+  void Add(
+      std::shared_ptr<IWindow> window
+    );
+
+  void Show();
+
+  std::size_t GetSize() const;
+
+  // Stable "name###id" label of the i-th window
+  const char * GetLabel(
+      const std::size_t i
+    ) const;
+
+  // True when a window shown in the last frame is animating
+  bool IsAnimating() const;
+
+private: // Types
+
+  struct Entry
+  {
+    std::shared_ptr<IWindow> Window;
+    std::string              Name;
+    std::string              Label;
+  };
+
+private: // Service
+
+  static void UpdateLabel(
+      Entry & entry
+    );
+
+private: // Members
+
+  std::vector<Entry> m_Entries;
+};
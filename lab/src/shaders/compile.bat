@@ -0,0 +1,15 @@
+@echo off
+rem Compiles the shaders next to this script to SPIR-V, see compile.sh
+
+pushd "%~dp0"
+
+for %%S in (*.vert *.frag *.comp) do (
+  glslangValidator -V %%S -o %%S.spv || goto :error
+)
+
+popd
+exit /b 0
+
+:error
+popd
+exit /b 1
@@ -0,0 +1,23 @@
+#!/bin/sh
+#
+# Compiles the shaders next to this script to SPIR-V. The application
+# loads them from "shaders/<name>.spv" relative to its working directory,
+# so run it from lab/src or copy this directory next to the executable.
+#
+# Uses glslangValidator from the Vulkan SDK, or glslc when that is the
+# one on the PATH.
+#
+
+set -e
+
+cd "$(dirname "$0")"
+
+for Shader in *.vert *.frag *.comp
+do
+  if command -v glslangValidator > /dev/null
+  then
+    glslangValidator -V "$Shader" -o "$Shader.spv"
+  else
+    glslc "$Shader" -o "$Shader.spv"
+  fi
+done
@@ -0,0 +1,69 @@
+#version 450
+
+layout(location = 0) in vec2 vLocal;
+layout(location = 1) flat in float vLength;
+layout(location = 2) flat in vec2 vPrevious;
+layout(location = 3) flat in vec2 vNext;
+layout(location = 4) flat in vec2 vStartSplit;
+layout(location = 5) flat in vec2 vEndSplit;
+
+layout(push_constant) uniform PushConstants
+{
+  vec2  Scale;
+  vec2  Translate;
+  vec4  Color;
+  vec2  ViewportSize;
+  float HalfWidth;
+} pc;
+
+layout(location = 0) out vec4 fColor;
+
+// Distances computed by two instances in their own frames differ by
+// rounding, closer than this they count as equal
+const float TIE = 1e-3;
+
+float GetDistance(vec2 p, vec2 a, vec2 b)
+{
+  const vec2 ab = b - a;
+  const float t = clamp(dot(p - a, ab) / dot(ab, ab), 0.0, 1.0);
+  return length(p - a - ab * t);
+}
+
+void main()
+{
+  // Distance to the segment itself: the ends are round, so consecutive
+  // segments meet in round joins without any join geometry
+  const float Distance = length(vec2(vLocal.x - clamp(vLocal.x, 0.0, vLength), vLocal.y));
+
+  // Pixel coverage of the stroke edge, thin strokes fade instead of
+  // breaking up
+  const float Coverage = clamp(pc.HalfWidth + 0.5 - Distance, 0.0, 1.0);
+
+  if (Coverage <= 0.0)
+    discard;
+
+  // Neighbouring segments overlap around their join, a pixel there is drawn
+  // only by the segment closer to it, so a translucent stroke is not
+  // blended twice and the coverage is that of the whole stroke. Where both
+  // are as close (the round outside of the join), the bisector decides, and
+  // folded back segments leave the pixel to the earlier one. Segments that
+  // are not adjacent still blend twice where they cross.
+  if (vPrevious != vec2(0))
+  {
+    const float Other = GetDistance(vLocal, vPrevious, vec2(0));
+
+    if (Other < Distance - TIE || (Other <= Distance + TIE && dot(vLocal, vStartSplit) <= 0.0))
+      discard;
+  }
+
+  if (vNext != vec2(0))
+  {
+    const vec2 FromEnd = vLocal - vec2(vLength, 0.0);
+    const float Other = GetDistance(FromEnd, vec2(0), vNext);
+
+    if (Other < Distance - TIE || (Other <= Distance + TIE && dot(FromEnd, vEndSplit) > 0.0))
+      discard;
+  }
+
+  fColor = vec4(pc.Color.rgb, pc.Color.a * Coverage);
+}
@@ -0,0 +1,81 @@
+#version 450
+
+// One instance per polyline segment. The same buffer is bound four times
+// at the instance rate with a stride of one point, so instance i reads the
+// point before the segment, its two ends and the point after it. The four
+// vertices of the instance span a quad around the segment's capsule, the
+// fragment shader cuts the stroke out of it.
+layout(location = 0) in vec2 aPrevious;
+layout(location = 1) in vec2 aStart;
+layout(location = 2) in vec2 aEnd;
+layout(location = 3) in vec2 aNext;
+
+layout(push_constant) uniform PushConstants
+{
+  vec2  Scale;        // Canvas -> framebuffer pixels
+  vec2  Translate;
+  vec4  Color;
+  vec2  ViewportSize; // Framebuffer pixels
+  float HalfWidth;    // Framebuffer pixels
+} pc;
+
+// Position along and across the segment, in pixels from its start
+layout(location = 0) out vec2 vLocal;
+layout(location = 1) flat out float vLength;
+// Neighbour points relative to the start and the end of the segment in
+// the frame of vLocal, zero when the segment has no neighbour there
+layout(location = 2) flat out vec2 vPrevious;
+layout(location = 3) flat out vec2 vNext;
+// Normals of the bisectors of the joins at the start and the end
+layout(location = 4) flat out vec2 vStartSplit;
+layout(location = 5) flat out vec2 vEndSplit;
+
+// Unit direction from p to q, zero when the points coincide
+vec2 GetDirection(vec2 p, vec2 q)
+{
+  const float Length = length(q - p);
+  return Length > 0.0 ? (q - p) / Length : vec2(0);
+}
+
+// Zero when the segments fold back onto each other
+vec2 GetSplit(vec2 incoming, vec2 outgoing)
+{
+  const vec2 Sum = incoming + outgoing;
+  return dot(Sum, Sum) < 1e-6 ? vec2(0) : normalize(Sum);
+}
+
+void main()
+{
+  const vec2 p = aPrevious * pc.Scale + pc.Translate;
+  const vec2 a = aStart * pc.Scale + pc.Translate;
+  const vec2 b = aEnd * pc.Scale + pc.Translate;
+  const vec2 n = aNext * pc.Scale + pc.Translate;
+
+  const float Length = length(b - a);
+
+  // An empty segment between others is drawn by their caps, they see no
+  // neighbour on its side and keep their caps whole
+  if (Length == 0.0 && (p != a || n != b))
+  {
+    gl_Position = vec4(0, 0, 0, 1);
+    return;
+  }
+
+  const vec2 Direction = Length > 0.0 ? (b - a) / Length : vec2(1, 0);
+  const vec2 Normal = vec2(-Direction.y, Direction.x);
+  const mat2 ToLocal = transpose(mat2(Direction, Normal));
+
+  // One extra pixel on every side for the anti-aliased edge
+  const float Extent = pc.HalfWidth + 1.0;
+  const vec2 Corner = vec2(gl_VertexIndex & 1, gl_VertexIndex >> 1);
+  const vec2 Local = vec2(mix(-Extent, Length + Extent, Corner.x), mix(-Extent, Extent, Corner.y));
+  const vec2 Position = a + Direction * Local.x + Normal * Local.y;
+
+  vLocal = Local;
+  vLength = Length;
+  vPrevious = ToLocal * (p - a);
+  vNext = ToLocal * (n - b);
+  vStartSplit = ToLocal * GetSplit(GetDirection(p, a), Direction);
+  vEndSplit = ToLocal * GetSplit(Direction, GetDirection(b, n));
+  gl_Position = vec4(Position / pc.ViewportSize * 2.0 - 1.0, 0, 1);
+}